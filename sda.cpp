@@ -17,6 +17,46 @@
 #include <algorithm>
 #include <map>
 #include <set>
+#include <deque>
+#include <unordered_map>
+#include <unordered_set>
+#include <tuple>
+#include <iterator>
+#include <cstdint>
+#include <climits>
+#include <cstring>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <string_view>
+#include <bitset>
+#include <array>
+#include <thread>
+#include <chrono>
+#include <ctime>
+#include <mutex>
+#include <memory>
+#include <atomic>
+#include <shared_mutex>
+#include <condition_variable>
+#include <csignal>
+#if defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#endif
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#endif
 
 using namespace std;
 
@@ -73,26 +113,29 @@ public:
      * @return true if valid, false otherwise.
      */
     static bool IsValidTime(const string &t)
+    {
+        return ParseTime(t) >= 0;
+    }
+
+    /**
+     * @brief Parses an HH:MM string into minutes since midnight.
+     * @param t Time string (expected HH:MM).
+     * @return Minute of day, or -1 if the string is not a valid time.
+     */
+    static int ParseTime(const string &t)
     {
         // Check length and separator position
         if (t.length() != 5 || t[2] != ':')
-            return false;
+            return -1;
 
         // Check if characters are digits
         if (!isdigit(t[0]) || !isdigit(t[1]) || !isdigit(t[3]) || !isdigit(t[4]))
-            return false;
+            return -1;
 
-        try
-        {
-            int h = stoi(t.substr(0, 2));
-            int m = stoi(t.substr(3, 2));
-            // Validate logical range for hours and minutes
-            return (h >= 0 && h < 24 && m >= 0 && m < 60);
-        }
-        catch (...)
-        {
-            return false;
-        }
+        int h = (t[0] - '0') * 10 + (t[1] - '0');
+        int m = (t[3] - '0') * 10 + (t[4] - '0');
+        // Validate logical range for hours and minutes
+        return (h < 24 && m < 60) ? h * 60 + m : -1;
     }
 
     /**
@@ -103,17 +146,11 @@ public:
      */
     static bool IsStartBeforeEnd(const string &start, const string &end)
     {
-        // Ensure basic format is valid first
-        if (!IsValidTime(start) || !IsValidTime(end))
-            return false;
+        int s = ParseTime(start);
+        int e = ParseTime(end);
 
-        int h1 = stoi(start.substr(0, 2));
-        int m1 = stoi(start.substr(3, 2));
-        int h2 = stoi(end.substr(0, 2));
-        int m2 = stoi(end.substr(3, 2));
-
-        // Compare total minutes from midnight
-        return (h1 * 60 + m1) < (h2 * 60 + m2);
+        // Both must be valid; compare total minutes from midnight
+        return s >= 0 && e >= 0 && s < e;
     }
 
     /**
@@ -160,6 +197,16 @@ public:
      * @return true if valid.
      */
     static bool IsValidDate(const string &d)
+    {
+        int year, month, day;
+        return ParseDate(d, year, month, day);
+    }
+
+    /**
+     * @brief Parses and validates a YYYY-MM-DD date.
+     * @return true and fills year/month/day if valid.
+     */
+    static bool ParseDate(const string &d, int &year, int &month, int &day)
     {
         // Expected Format check: YYYY-MM-DD (Length 10)
         if (d.length() != 10)
@@ -176,1727 +223,9322 @@ public:
                 return false;
         }
 
-        try
-        {
-            int year = stoi(d.substr(0, 4));
-            int month = stoi(d.substr(5, 2));
-            int day = stoi(d.substr(8, 2));
+        year = (d[0] - '0') * 1000 + (d[1] - '0') * 100 + (d[2] - '0') * 10 + (d[3] - '0');
+        month = (d[5] - '0') * 10 + (d[6] - '0');
+        day = (d[8] - '0') * 10 + (d[9] - '0');
 
-            // Range checks
-            if (year < 1900 || year > 2100)
-                return false;
-            if (month < 1 || month > 12)
-                return false;
+        // Range checks; dates are packed as days since 1970-01-01 and negative
+        // day numbers are the weekly slots, so earlier years cannot be stored
+        if (year < 1970 || year > 2100)
+            return false;
+        if (month < 1 || month > 12)
+            return false;
 
-            // Days in each month
-            int daysInMonth[] = {0, 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+        // Days in each month
+        int daysInMonth[] = {0, 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
 
-            // Adjust February for leap years
-            if (IsLeapYear(year))
-                daysInMonth[2] = 29;
+        // Adjust February for leap years
+        if (IsLeapYear(year))
+            daysInMonth[2] = 29;
 
-            return day >= 1 && day <= daysInMonth[month];
-        }
-        catch (...)
-        {
-            return false;
-        }
+        return day >= 1 && day <= daysInMonth[month];
     }
-};
 
-// ==========================================
-// CORE DOMAIN ENTITIES
-// ==========================================
+    /**
+     * @brief Parses a weekday name, case-insensitively.
+     * @return 0 for Monday through 6 for Sunday, or -1 if not a weekday.
+     */
+    static int ParseWeekday(const string &s)
+    {
+        static const char *names[] = {"monday", "tuesday", "wednesday", "thursday", "friday", "saturday", "sunday"};
+        size_t b = s.find_first_not_of(" \t");
+        size_t e = s.find_last_not_of(" \t");
+        if (b == string::npos)
+            return -1;
+
+        string lower;
+        for (size_t i = b; i <= e; i++)
+            lower += static_cast<char>(tolower(static_cast<unsigned char>(s[i])));
+        for (int i = 0; i < 7; i++)
+            if (lower == names[i])
+                return i;
+        return -1;
+    }
+
+    /**
+     * @brief Accepts either a YYYY-MM-DD date or a weekday name.
+     */
+    static bool IsValidDay(const string &s)
+    {
+        return IsValidDate(s) || ParseWeekday(s) >= 0;
+    }
+};
 
 /**
- * @class DateAndTime
- * @brief Encapsulates scheduling timing information.
+ * @class SymbolTable
+ * @brief Process-wide interner for repeated names (sections, course codes, venues).
+ * * Each distinct string is stored once and identified by a 32-bit ID, so domain
+ * objects hold IDs and equality checks become integer compares. ID 0 is the
+ * empty string, which makes default-constructed entities valid.
+ * * Intern and Find serialize on a mutex so loader threads can intern concurrently.
+ * Strings live in fixed-size blocks under a two-level directory that spans every
+ * 32-bit ID, so a published string never moves, Name() reads without locking and
+ * the table cannot fill up before memory does.
  */
-class DateAndTime
+typedef uint32_t SymbolId;
+
+class SymbolTable
 {
 private:
-    string date;
-    string startTime;
-    string endTime;
+    static const SymbolId BLOCK_BITS = 12;
+    static const SymbolId BLOCK_SIZE = 1u << BLOCK_BITS;
+    static const SymbolId DIR_BITS = 10;
+    static const SymbolId DIR_SIZE = 1u << DIR_BITS; // DIR_SIZE^2 blocks of BLOCK_SIZE cover 2^32 IDs
+
+    unique_ptr<unique_ptr<string[]>[]> directories[DIR_SIZE];
+    SymbolId count;
+    unordered_map<string_view, SymbolId> ids; // views into blocks
+    mutable mutex lock;
+
+    SymbolTable() : count(0) { Intern(""); }
 
 public:
-    void Set(const string &d, const string &s, const string &e)
+    static SymbolTable &Instance()
     {
-        date = d;
-        startTime = s;
-        endTime = e;
+        static SymbolTable table;
+        return table;
     }
-    string GetDate() const { return date; }
-    string GetStartTime() const { return startTime; }
-    string GetEndTime() const { return endTime; }
-};
 
-class CampusBlock
-{
-private:
-    int buildingId;
-    string name;
+    SymbolId Intern(const string &s)
+    {
+        lock_guard<mutex> guard(lock);
+        auto it = ids.find(s);
+        if (it != ids.end())
+            return it->second;
+        SymbolId id = count;
+        if (id == UINT32_MAX)
+        {
+            // Only reachable after billions of names; any ID handed out now would alias another
+            cerr << "Fatal: symbol table is full.\n";
+            abort();
+        }
+        unique_ptr<unique_ptr<string[]>[]> &dir = directories[id >> (BLOCK_BITS + DIR_BITS)];
+        if (!dir)
+            dir.reset(new unique_ptr<string[]>[DIR_SIZE]);
+        unique_ptr<string[]> &block = dir[(id >> BLOCK_BITS) & (DIR_SIZE - 1)];
+        if (!block)
+            block.reset(new string[BLOCK_SIZE]);
+        string &slot = block[id & (BLOCK_SIZE - 1)];
+        slot = s;
+        ids.emplace(string_view(slot), id);
+        count++;
+        return id;
+    }
 
-public:
-    CampusBlock() : buildingId(0) {}
-    CampusBlock(int id, string n) : buildingId(id), name(n) {}
+    /**
+     * @brief Looks a string up without interning it.
+     * @return false if the string has never been interned.
+     */
+    bool Find(const string &s, SymbolId &id) const
+    {
+        lock_guard<mutex> guard(lock);
+        auto it = ids.find(s);
+        if (it == ids.end())
+            return false;
+        id = it->second;
+        return true;
+    }
 
-    int GetId() const { return buildingId; }
-    string GetName() const { return name; }
+    const string &Name(SymbolId id) const
+    {
+        return directories[id >> (BLOCK_BITS + DIR_BITS)][(id >> BLOCK_BITS) & (DIR_SIZE - 1)][id & (BLOCK_SIZE - 1)];
+    }
+    size_t Size() const
+    {
+        lock_guard<mutex> guard(lock);
+        return count;
+    }
 };
 
-class LectureHall
+/**
+ * @class ParallelFor
+ * @brief Splits [0, n) into contiguous chunks and runs them on worker threads.
+ */
+class ParallelFor
 {
-private:
-    int roomId;
-    string roomNumber;
-    int buildingId;
-    CampusBlock *building; // Pointer to the parent building object
-
 public:
-    LectureHall() : roomId(0), roomNumber(""), buildingId(0), building(nullptr) {}
-    LectureHall(int id, string num, int bId, CampusBlock *bldg)
-        : roomId(id), roomNumber(num), buildingId(bId), building(bldg) {}
-
-    int GetId() const { return roomId; }
-    string GetRoomNumber() const { return roomNumber; }
-    int GetBuildingId() const { return buildingId; }
-    CampusBlock *GetBuilding() const { return building; }
+    /**
+     * @brief Chunks to use for n items: one per worker, each at least minPerChunk items.
+     */
+    static size_t ChunkCount(size_t n, size_t minPerChunk, size_t workers = thread::hardware_concurrency())
+    {
+        return max<size_t>(1, min<size_t>(max<size_t>(1, workers), n / minPerChunk));
+    }
 
-    void SetBuilding(CampusBlock *b) { building = b; }
+    /**
+     * @brief Calls body(chunk, lo, hi) for every chunk; chunk 0 runs on the calling thread.
+     */
+    static void Run(size_t n, size_t chunks, const function<void(size_t, size_t, size_t)> &body)
+    {
+        size_t per = (n + chunks - 1) / chunks;
+        vector<thread> pool;
+        for (size_t c = 1; c < chunks; c++)
+            pool.emplace_back(body, c, min(n, c * per), min(n, (c + 1) * per));
+        body(0, 0, min(n, per));
+        for (auto &t : pool)
+            t.join();
+    }
 };
 
-class UniversityTeacher
+/**
+ * @class LockFreeAppendList
+ * @brief Multi-producer append list drained in batches by a single consumer at a time.
+ * * Append pushes a node with one compare-and-swap on the head, so producers never
+ * wait on each other or on the consumer. Drain detaches the whole list with an
+ * atomic exchange and reverses it, yielding entries in append order (per producer).
+ */
+template <typename T>
+class LockFreeAppendList
 {
-private:
-    int teacherId;
-    string name;
+    struct Node
+    {
+        T value;
+        Node *next;
+    };
+
+    atomic<Node *> head;
 
 public:
-    UniversityTeacher() : teacherId(0) {}
-    UniversityTeacher(int id, string n) : teacherId(id), name(n) {}
+    LockFreeAppendList() : head(nullptr) {}
+    ~LockFreeAppendList()
+    {
+        Drain([](const T &) {});
+    }
+    LockFreeAppendList(const LockFreeAppendList &) = delete;
+    LockFreeAppendList &operator=(const LockFreeAppendList &) = delete;
 
-    int GetId() const { return teacherId; }
-    string GetName() const { return name; }
-};
+    void Append(const T &value)
+    {
+        Node *n = new Node{value, head.load(memory_order_relaxed)};
+        while (!head.compare_exchange_weak(n->next, n, memory_order_release, memory_order_relaxed))
+        {
+        }
+    }
 
-class TeachingAssistant
-{
-private:
-    int taId;
-    string name;
+    bool Empty() const { return head.load(memory_order_acquire) == nullptr; }
 
-public:
-    TeachingAssistant() : taId(0) {}
-    TeachingAssistant(int id, string n) : taId(id), name(n) {}
+    /**
+     * @brief Removes everything appended so far and visits it oldest first.
+     * @return Number of entries visited.
+     */
+    template <typename Fn>
+    size_t Drain(Fn consume)
+    {
+        Node *n = head.exchange(nullptr, memory_order_acquire);
+        Node *ordered = nullptr;
+        while (n)
+        {
+            Node *next = n->next;
+            n->next = ordered;
+            ordered = n;
+            n = next;
+        }
 
-    int GetId() const { return taId; }
-    string GetName() const { return name; }
+        size_t count = 0;
+        while (ordered)
+        {
+            Node *next = ordered->next;
+            consume(ordered->value);
+            delete ordered;
+            ordered = next;
+            count++;
+        }
+        return count;
+    }
 };
 
 /**
- * @class ClassSection
- * @brief Represents a specific scheduled instance of a course.
- * Links Teachers, TAs, Rooms, and Times.
+ * @class MappedFile
+ * @brief Read-only view over a whole data file.
+ * * On POSIX systems the file is memory-mapped so loading touches no per-field
+ * syscalls; elsewhere it falls back to a single bulk read into memory.
  */
-class ClassSection
+class MappedFile
 {
 private:
-    string sectionName;
-    UniversityTeacher *teacher;
-    vector<TeachingAssistant *> assistants;
-    CampusBlock *building;
-    LectureHall *room;
-    DateAndTime scheduleTime;
+    const char *data;
+    size_t size;
+    bool open;
+#ifdef _WIN32
+    vector<char> buffer;
+#else
+    void *mapping;
+#endif
 
 public:
-    ClassSection() : teacher(nullptr), building(nullptr), room(nullptr) {}
-
-    void SetDetails(string name, UniversityTeacher *t, CampusBlock *b, LectureHall *r)
+    explicit MappedFile(const string &path) : data(nullptr), size(0), open(false)
     {
-        sectionName = name;
-        teacher = t;
-        building = b;
-        room = r;
+#ifdef _WIN32
+        ifstream in(path, ios::binary | ios::ate);
+        if (!in.is_open())
+            return;
+        open = true;
+        size = static_cast<size_t>(in.tellg());
+        buffer.resize(size);
+        in.seekg(0);
+        if (size > 0 && !in.read(buffer.data(), size))
+            size = 0;
+        data = buffer.data();
+#else
+        mapping = nullptr;
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            return;
+        open = true;
+        struct stat st;
+        if (fstat(fd, &st) == 0 && st.st_size > 0)
+        {
+            void *m = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (m != MAP_FAILED)
+            {
+                mapping = m;
+                data = static_cast<const char *>(m);
+                size = static_cast<size_t>(st.st_size);
+            }
+        }
+        ::close(fd);
+#endif
     }
 
-    void AddTA(TeachingAssistant *ta)
+    ~MappedFile()
     {
-        assistants.push_back(ta);
+#ifndef _WIN32
+        if (mapping)
+            munmap(mapping, size);
+#endif
     }
 
-    // Getters
-    string GetSectionName() const { return sectionName; }
-    UniversityTeacher *GetTeacher() const { return teacher; }
-    const vector<TeachingAssistant *> &GetAssistants() const { return assistants; }
-    CampusBlock *GetBuilding() const { return building; }
-    LectureHall *GetRoom() const { return room; }
-    DateAndTime &GetScheduleTime() { return scheduleTime; }
-    const DateAndTime &GetScheduleTime() const { return scheduleTime; }
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
 
-    // Setters used for data loading reconstruction
-    void SetSectionName(const string &n) { sectionName = n; }
-    void SetTeacher(UniversityTeacher *t) { teacher = t; }
-    void SetBuilding(CampusBlock *b) { building = b; }
-    void SetRoom(LectureHall *r) { room = r; }
+    bool IsOpen() const { return open; }
+    const char *Data() const { return data; }
+    size_t Size() const { return size; }
 };
 
-class CourseLaboratory
+/**
+ * @class Crc32c
+ * @brief CRC-32C (Castagnoli) checksum used to verify .dat blocks.
+ * * Uses the SSE4.2 / ARMv8 CRC instructions when the CPU has them and a
+ * byte-wise table otherwise; both produce the same value.
+ */
+class Crc32c
 {
 private:
-    int labId;
-    string courseCode;
-    vector<ClassSection> sections;
+    static const uint32_t POLY = 0x82F63B78; // reflected Castagnoli polynomial
 
-public:
-    CourseLaboratory() : labId(0) {}
+    static const uint32_t *Table()
+    {
+        static const array<uint32_t, 256> table = []
+        {
+            array<uint32_t, 256> t{};
+            for (uint32_t i = 0; i < 256; i++)
+            {
+                uint32_t c = i;
+                for (int k = 0; k < 8; k++)
+                    c = (c & 1) ? (c >> 1) ^ POLY : c >> 1;
+                t[i] = c;
+            }
+            return t;
+        }();
+        return table.data();
+    }
 
-    void AddSection(const ClassSection &s)
+    static uint32_t Software(uint32_t crc, const char *data, size_t size)
     {
-        sections.push_back(s);
+        const uint32_t *t = Table();
+        const unsigned char *p = reinterpret_cast<const unsigned char *>(data);
+        for (size_t i = 0; i < size; i++)
+            crc = t[(crc ^ p[i]) & 0xFF] ^ (crc >> 8);
+        return crc;
     }
 
-    ClassSection *FindSection(const string &secName)
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+    __attribute__((target("sse4.2"))) static uint32_t Hardware(uint32_t crc, const char *data, size_t size)
     {
-        for (auto &s : sections)
+        uint64_t c = crc;
+        for (; size >= 8; data += 8, size -= 8)
         {
-            if (s.GetSectionName() == secName)
-                return &s;
+            uint64_t word;
+            memcpy(&word, data, 8);
+            c = __builtin_ia32_crc32di(c, word);
         }
-        return nullptr;
+        uint32_t c32 = static_cast<uint32_t>(c);
+        for (; size > 0; data++, size--)
+            c32 = __builtin_ia32_crc32qi(c32, static_cast<unsigned char>(*data));
+        return c32;
     }
 
-    int GetLabId() const { return labId; }
-    void SetLabId(int id) { labId = id; }
-    string GetCourseCode() const { return courseCode; }
-    void SetCourseCode(const string &code) { courseCode = code; }
-    vector<ClassSection> &GetSections() { return sections; }
-    const vector<ClassSection> &GetSections() const { return sections; }
-};
+    static bool HasHardware()
+    {
+        static const bool supported = __builtin_cpu_supports("sse4.2");
+        return supported;
+    }
+#elif defined(__ARM_FEATURE_CRC32)
+    static uint32_t Hardware(uint32_t crc, const char *data, size_t size)
+    {
+        for (; size >= 8; data += 8, size -= 8)
+        {
+            uint64_t word;
+            memcpy(&word, data, 8);
+            crc = __crc32cd(crc, word);
+        }
+        for (; size > 0; data++, size--)
+            crc = __crc32cb(crc, static_cast<uint8_t>(*data));
+        return crc;
+    }
 
-class WorkLog
-{
-private:
-    int labId;
-    string sectionName;
-    DateAndTime actualTiming;
-    bool isLeave;
+    static bool HasHardware() { return true; }
+#else
+    static uint32_t Hardware(uint32_t crc, const char *data, size_t size) { return Software(crc, data, size); }
+    static bool HasHardware() { return false; }
+#endif
 
 public:
-    WorkLog() : labId(0), isLeave(false) {}
-
-    int GetLabId() const { return labId; }
-    void SetLabId(int id) { labId = id; }
-    string GetSectionName() const { return sectionName; }
-    void SetSectionName(const string &n) { sectionName = n; }
-    const DateAndTime &GetActualTiming() const { return actualTiming; }
-    DateAndTime &GetActualTiming() { return actualTiming; }
-    bool GetIsLeave() const { return isLeave; }
-    void SetIsLeave(bool l) { isLeave = l; }
+    static uint32_t Compute(const char *data, size_t size)
+    {
+        uint32_t crc = 0xFFFFFFFFu;
+        crc = HasHardware() ? Hardware(crc, data, size) : Software(crc, data, size);
+        return crc ^ 0xFFFFFFFFu;
+    }
 };
 
-class MakeupLabRequest
+/**
+ * @class ByteReader
+ * @brief Bounds-checked cursor over an in-memory byte range.
+ * * Integers are little-endian whatever the host. Strings are built straight
+ * from the source bytes; a length that runs past the end of the buffer stops
+ * the read instead of triggering an allocation.
+ */
+class ByteReader
 {
 private:
-    CourseLaboratory *lab;
-    string sectionName;
-    string requestedStartTime;
-    string requestedEndTime;
-    string requestedDate;
+    const char *cur;
+    const char *end;
+    bool ok;
 
 public:
-    MakeupLabRequest() : lab(nullptr) {}
-    MakeupLabRequest(CourseLaboratory *l, const string &sec, const string &date, const string &start, const string &end)
-        : lab(l), sectionName(sec), requestedDate(date), requestedStartTime(start), requestedEndTime(end) {}
-
-    CourseLaboratory *GetLab() const { return lab; }
-    void SetLab(CourseLaboratory *l) { lab = l; }
-    string GetSectionName() const { return sectionName; }
-    void SetSectionName(const string &s) { sectionName = s; }
-    string GetRequestedDate() const { return requestedDate; }
-    void SetRequestedDate(const string &d) { requestedDate = d; }
-    string GetRequestedStartTime() const { return requestedStartTime; }
-    void SetRequestedStartTime(const string &s) { requestedStartTime = s; }
-    string GetRequestedEndTime() const { return requestedEndTime; }
-    void SetRequestedEndTime(const string &e) { requestedEndTime = e; }
-};
-
-// ==========================================
-// DETAILS INTERFACES & IMPLEMENTATIONS
-// ==========================================
+    ByteReader(const char *data, size_t size) : cur(data), end(data + size), ok(data != nullptr) {}
 
-class LabDetails
-{
-public:
-    virtual void AddLab(const CourseLaboratory &l) = 0;
-    virtual void UpdateLab(const CourseLaboratory &l) = 0;
-    virtual CourseLaboratory *FindLab(int id) = 0;
-    virtual vector<CourseLaboratory> &GetAllLabs() = 0;
-};
+    bool Ok() const { return ok; }
+    size_t Remaining() const { return static_cast<size_t>(end - cur); }
+    const char *Position() const { return cur; }
 
-class WorkLogDetails
-{
-public:
-    virtual void AddEntry(const WorkLog &entry) = 0;
-    virtual vector<WorkLog> &GetAllEntries() = 0;
-};
+    bool Skip(size_t bytes)
+    {
+        if (!ok || Remaining() < bytes)
+            return ok = false;
+        cur += bytes;
+        return true;
+    }
 
-class VenueDetails
-{
-public:
-    virtual void AddBuilding(const CampusBlock &b) = 0;
-    virtual void AddRoom(const LectureHall &r) = 0;
-    virtual CampusBlock *FindBuilding(int id) = 0;
-    virtual LectureHall *FindRoom(int id) = 0;
-    virtual vector<CampusBlock> &GetAllBuildings() = 0;
-    virtual vector<LectureHall> &GetAllRooms() = 0;
-};
+    /**
+     * @brief Steps over a length-prefixed string without copying it.
+     */
+    bool SkipString()
+    {
+        int len;
+        if (!ReadInt(len))
+            return false;
+        return len <= 0 || Skip(static_cast<size_t>(len));
+    }
 
-class FacultyDetails
-{
-public:
-    virtual void AddTeacher(const UniversityTeacher &t) = 0;
-    virtual void AddTA(const TeachingAssistant &t) = 0;
-    virtual UniversityTeacher *FindTeacher(int id) = 0;
-    virtual TeachingAssistant *FindTA(int id) = 0;
-    virtual vector<UniversityTeacher> &GetAllTeachers() = 0;
-    virtual vector<TeachingAssistant> &GetAllTAs() = 0;
-};
+    bool ReadUInt32(uint32_t &val)
+    {
+        if (!ok || end - cur < 4)
+            return ok = false;
+        const unsigned char *p = reinterpret_cast<const unsigned char *>(cur);
+        val = static_cast<uint32_t>(p[0]) | static_cast<uint32_t>(p[1]) << 8 |
+              static_cast<uint32_t>(p[2]) << 16 | static_cast<uint32_t>(p[3]) << 24;
+        cur += 4;
+        return true;
+    }
 
-// In-Memory Implementations using STL vectors
+    bool ReadUInt64(uint64_t &val)
+    {
+        uint32_t lo, hi;
+        if (!ReadUInt32(lo) || !ReadUInt32(hi))
+            return false;
+        val = static_cast<uint64_t>(hi) << 32 | lo;
+        return true;
+    }
 
-class InMemoryLabDetails : public LabDetails
-{
-    vector<CourseLaboratory> labs;
-
-public:
-    void AddLab(const CourseLaboratory &l) override { labs.push_back(l); }
-    void UpdateLab(const CourseLaboratory &l) override
-    {
-        for (auto &existing : labs)
-        {
-            if (existing.GetLabId() == l.GetLabId())
-            {
-                existing = l;
-                return;
-            }
-        }
-    }
-    CourseLaboratory *FindLab(int id) override
+    bool ReadInt(int &val)
     {
-        for (auto &l : labs)
-            if (l.GetLabId() == id)
-                return &l;
-        return nullptr;
+        uint32_t raw;
+        if (!ReadUInt32(raw))
+            return false;
+        val = static_cast<int32_t>(raw);
+        return true;
     }
-    vector<CourseLaboratory> &GetAllLabs() override { return labs; }
-};
 
-class InMemoryWorkLogDetails : public WorkLogDetails
-{
-    vector<WorkLog> logs;
-
-public:
-    void AddEntry(const WorkLog &entry) override { logs.push_back(entry); }
-    vector<WorkLog> &GetAllEntries() override { return logs; }
-};
-
-class InMemoryVenueDetails : public VenueDetails
-{
-    vector<CampusBlock> buildings;
-    vector<LectureHall> rooms;
-
-public:
-    void AddBuilding(const CampusBlock &b) override { buildings.push_back(b); }
-    void AddRoom(const LectureHall &r) override { rooms.push_back(r); }
-
-    CampusBlock *FindBuilding(int id) override
+    bool ReadBool(bool &val)
     {
-        for (auto &b : buildings)
-            if (b.GetId() == id)
-                return &b;
-        return nullptr;
+        if (!ok || end - cur < 1)
+            return ok = false;
+        val = *cur != 0;
+        cur += 1;
+        return true;
     }
-    LectureHall *FindRoom(int id) override
+
+    /**
+     * @brief Reads an int length prefix followed by that many bytes.
+     * Non-positive lengths decode as an empty string, as the writer never emits them.
+     */
+    bool ReadString(string &val)
     {
-        for (auto &r : rooms)
-            if (r.GetId() == id)
-                return &r;
-        return nullptr;
+        int len;
+        if (!ReadInt(len))
+            return false;
+        if (len <= 0)
+        {
+            val.clear();
+            return true;
+        }
+        if (end - cur < len)
+            return ok = false;
+        val.assign(cur, static_cast<size_t>(len));
+        cur += len;
+        return true;
     }
-    vector<CampusBlock> &GetAllBuildings() override { return buildings; }
-    vector<LectureHall> &GetAllRooms() override { return rooms; }
 };
 
-class InMemoryFacultyDetails : public FacultyDetails
+/**
+ * @class ByteWriter
+ * @brief Appends fields into an in-memory buffer in the .dat layout.
+ * * Mirrors ByteReader: 32-bit little-endian ints, one-byte bools and
+ * int-length-prefixed strings.
+ */
+class ByteWriter
 {
-    vector<UniversityTeacher> teachers;
-    vector<TeachingAssistant> tas;
+private:
+    string buf;
 
 public:
-    void AddTeacher(const UniversityTeacher &t) override { teachers.push_back(t); }
-    void AddTA(const TeachingAssistant &t) override { tas.push_back(t); }
-
-    UniversityTeacher *FindTeacher(int id) override
+    void WriteUInt32(uint32_t val)
     {
-        for (auto &t : teachers)
-            if (t.GetId() == id)
-                return &t;
-        return nullptr;
+        char bytes[4] = {static_cast<char>(val), static_cast<char>(val >> 8), static_cast<char>(val >> 16),
+                         static_cast<char>(val >> 24)};
+        buf.append(bytes, 4);
     }
-    TeachingAssistant *FindTA(int id) override
+    void WriteUInt64(uint64_t val)
     {
-        for (auto &t : tas)
-            if (t.GetId() == id)
-                return &t;
-        return nullptr;
+        WriteUInt32(static_cast<uint32_t>(val));
+        WriteUInt32(static_cast<uint32_t>(val >> 32));
     }
-    vector<UniversityTeacher> &GetAllTeachers() override { return teachers; }
-    vector<TeachingAssistant> &GetAllTAs() override { return tas; }
+    void WriteInt(int val) { WriteUInt32(static_cast<uint32_t>(val)); }
+    void WriteBool(bool val) { buf.push_back(val ? 1 : 0); }
+    void WriteString(const string &str)
+    {
+        WriteInt(static_cast<int>(str.length()));
+        buf.append(str);
+    }
+    void WriteRaw(const char *data, size_t size) { buf.append(data, size); }
+    const string &Data() const { return buf; }
+    size_t Size() const { return buf.size(); }
+    void Clear() { buf.clear(); }
 };
 
-// ==========================================
-// ACTOR ROLES
-// ==========================================
-
-class Person
+/**
+ * @class BlockFile
+ * @brief Framing for the snapshot (.dat) files.
+ * * A file is a header ("SDAT" magic, format version) followed by blocks of
+ * [payload length][CRC-32C of payload][payload]. Each payload is
+ * [table kind][record count][records], so a block only ever holds whole
+ * records of one table and can be decoded on its own. A block whose checksum
+ * does not match is skipped; a length that runs past the end of the file ends
+ * the scan. Files without the magic are the original headerless layout
+ * (version 1), which is still readable so old data upgrades on the next save.
+ * Version 3 added column-packed log blocks. Version 4 puts a name table after
+ * the record count, [name count][names], and records refer to interned names
+ * (section names, course codes, building names, room numbers) by their index
+ * in it; earlier versions write each name inline and still read unchanged.
+ */
+class BlockFile
 {
-protected:
-    string roleName;
-
 public:
-    Person(const string &n) : roleName(n) {}
-    virtual ~Person() {}
-};
+    static const uint32_t VERSION = 4;
+    static const uint32_t NAME_TABLE_VERSION = 4;
+    static const uint32_t FIRST_BLOCK_VERSION = 2;
+    static const uint32_t LEGACY_VERSION = 1;
+    static const size_t BLOCK_TARGET = 64 * 1024; // payload size at which a block is closed
+    static const size_t HEADER_SIZE = 8;
+    static const size_t BLOCK_HEADER_SIZE = 8;
+
+    struct Block
+    {
+        int kind;
+        int count;
+        const char *data; // first record, just past kind, count and any name table
+        size_t size;
+        const char *names; // the name table's first entry
+        int nameCount;     // -1 before NAME_TABLE_VERSION: records carry names inline
+    };
 
-class HOD : public Person
-{
-private:
     /**
-     * @brief Calculates the duration in hours between two time strings.
+     * @brief Result of scanning a file: its version, the intact blocks and what was skipped.
      */
-    float CalculateHours(const string &start, const string &end)
+    struct Image
     {
-        int h1 = stoi(start.substr(0, 2));
-        int m1 = stoi(start.substr(3, 2));
-        int h2 = stoi(end.substr(0, 2));
-        int m2 = stoi(end.substr(3, 2));
-        return (float)((h2 * 60 + m2) - (h1 * 60 + m1)) / 60.0f;
-    }
+        uint32_t version = 0; // 0 if the file is missing
+        vector<Block> blocks;
+        int corruptBlocks = 0;
+        size_t corruptBytes = 0;
+        bool truncated = false;
+    };
 
     /**
-     * @brief Attempts to extract day name from date string or returns original.
+     * @class Writer
+     * @brief Builds a current-version file record by record.
+     * * Call Record(kind) before encoding each record into the returned writer;
+     * a new block starts whenever the kind changes or the current one is full.
+     * Name(id) gives the index of an interned name in the open block's table.
      */
-    string ExtractDay(const string &date)
+    class Writer
     {
-        vector<string> days = {"Monday", "Tuesday", "Wednesday", "Thursday", "Friday", "Saturday", "Sunday"};
-        for (const string &day : days)
+    private:
+        ByteWriter file;
+        ByteWriter block;
+        int kind;
+        int count;
+        vector<SymbolId> names; // name table of the open block
+        unordered_map<SymbolId, int> nameIndex;
+
+        void WriteBlock(int blockKind, int records, const ByteWriter &body)
         {
-            if (date.find(day) != string::npos)
-                return day;
+            ByteWriter payload;
+            payload.WriteInt(blockKind);
+            payload.WriteInt(records);
+            payload.WriteInt(static_cast<int>(names.size()));
+            for (SymbolId id : names)
+                payload.WriteString(SymbolTable::Instance().Name(id));
+            payload.WriteRaw(body.Data().data(), body.Size());
+            file.WriteUInt32(static_cast<uint32_t>(payload.Size()));
+            file.WriteUInt32(Crc32c::Compute(payload.Data().data(), payload.Size()));
+            file.WriteRaw(payload.Data().data(), payload.Size());
         }
-        return date;
-    }
-
-    bool IsDateInWeek(const string &date, const string &weekIdentifier)
-    {
-        return date.find(weekIdentifier) != string::npos || weekIdentifier == "all";
-    }
 
-    /**
-     * @brief Displays the full schedule for the week, grouped by Day.
-     * It iterates through all labs and sections, grouping them by day.
-     */
-    void GenerateCompleteWeeklySchedule(LabDetails *lDetails)
-    {
-        cout << "\nComplete Lab Schedule - Entire Week\n";
-        cout << string(40, '=') << "\n";
-
-        vector<CourseLaboratory> &labs = lDetails->GetAllLabs();
+        void Flush()
+        {
+            if (count == 0)
+                return;
+            WriteBlock(kind, count, block);
+            block.Clear();
+            count = 0;
+            names.clear();
+            nameIndex.clear();
+        }
 
-        if (labs.empty())
+    public:
+        Writer() : kind(0), count(0)
         {
-            cout << "No labs scheduled for the week.\n";
-            return;
+            file.WriteRaw("SDAT", 4);
+            file.WriteUInt32(VERSION);
         }
 
-        // Group by Day (String) -> List of Lab/Section pairs
-        map<string, vector<pair<CourseLaboratory *, ClassSection *>>> scheduleByDay;
-        for (auto &lab : labs)
+        ByteWriter &Record(int recordKind)
         {
-            for (auto &sec : lab.GetSections())
-            {
-                string day = ExtractDay(sec.GetScheduleTime().GetDate());
-                scheduleByDay[day].push_back({&lab, &sec});
-            }
+            if (count > 0 && (recordKind != kind || block.Size() >= BLOCK_TARGET))
+                Flush();
+            kind = recordKind;
+            count++;
+            return block;
         }
 
-        // Define standard order for presentation
-        vector<string> dayOrder = {"Monday", "Tuesday", "Wednesday", "Thursday", "Friday", "Saturday", "Sunday"};
-        set<string> processedDays;
+        /**
+         * @brief Index of 'id' in the name table of the block that holds the current record.
+         */
+        int Name(SymbolId id)
+        {
+            auto it = nameIndex.emplace(id, static_cast<int>(names.size())).first;
+            if (it->second == static_cast<int>(names.size()))
+                names.push_back(id);
+            return it->second;
+        }
 
-        // Loop through standard days first
-        for (const string &day : dayOrder)
+        /**
+         * @brief Writes an already encoded block of records, e.g. a column-packed one.
+         */
+        void AppendBlock(int blockKind, int records, const ByteWriter &body)
         {
-            if (scheduleByDay.find(day) != scheduleByDay.end())
-            {
-                processedDays.insert(day);
-                cout << "\n--- " << day << " ---\n";
-                for (const auto &entry : scheduleByDay[day])
-                {
-                    CourseLaboratory *lab = entry.first;
-                    ClassSection *sec = entry.second;
-
-                    cout << "Lab ID: " << lab->GetLabId() << " | Course: " << lab->GetCourseCode() << "\n";
-                    cout << "  Section: " << sec->GetSectionName() << "\n";
-                    cout << "  Time: " << sec->GetScheduleTime().GetStartTime() << " - " << sec->GetScheduleTime().GetEndTime() << "\n";
-                    cout << "  Venue: " << (sec->GetBuilding() ? sec->GetBuilding()->GetName() : "N/A")
-                         << " - Room " << (sec->GetRoom() ? sec->GetRoom()->GetRoomNumber() : "N/A") << "\n";
-                    cout << "  Instructor: " << (sec->GetTeacher() ? sec->GetTeacher()->GetName() : "Unassigned") << "\n";
-                }
-            }
+            Flush();
+            WriteBlock(blockKind, records, body);
         }
 
-        // Loop through any non-standard date strings (e.g. "2023-10-15")
-        for (const auto &pair : scheduleByDay)
+        string Finish()
         {
-            if (processedDays.find(pair.first) == processedDays.end())
-            {
-                cout << "\n--- " << pair.first << " ---\n";
-                for (const auto &entry : pair.second)
-                {
-                    CourseLaboratory *lab = entry.first;
-                    ClassSection *sec = entry.second;
-                    cout << "Lab ID: " << lab->GetLabId() << " | Course: " << lab->GetCourseCode() << "\n";
-                    cout << "  Section: " << sec->GetSectionName() << "\n";
-                    cout << "  Time: " << sec->GetScheduleTime().GetStartTime() << " - " << sec->GetScheduleTime().GetEndTime() << "\n";
-                    cout << "  Venue: " << (sec->GetBuilding() ? sec->GetBuilding()->GetName() : "N/A")
-                         << " - Room " << (sec->GetRoom() ? sec->GetRoom()->GetRoomNumber() : "N/A") << "\n";
-                    cout << "  Instructor: " << (sec->GetTeacher() ? sec->GetTeacher()->GetName() : "Unassigned") << "\n";
-                }
-            }
+            Flush();
+            return file.Data();
         }
-        cout << string(40, '=') << "\n";
-    }
+    };
 
-    void GenerateWeeklyTimeSheetReport(LabDetails *lDetails, WorkLogDetails *logDetails)
-    {
-        cout << "\nFilled Time Sheets Report\n";
-        cout << string(40, '=') << "\n";
+    static bool IsBlocked(uint32_t version) { return version >= FIRST_BLOCK_VERSION && version <= VERSION; }
 
-        string weekInput;
-        cout << "Enter week identifier (e.g., 'Week1', 'all'): ";
-        InputOutput::SafeReadString(weekInput);
+    /**
+     * @brief Interns a block's name table into 'table'.
+     * @return The table, or nullptr for a block whose records carry their names inline.
+     */
+    static const vector<SymbolId> *ReadNames(const Block &b, vector<SymbolId> &table)
+    {
+        table.clear();
+        if (b.nameCount < 0)
+            return nullptr;
+        ByteReader in(b.names, static_cast<size_t>(b.data - b.names));
+        string name;
+        for (int i = 0; i < b.nameCount && in.ReadString(name); i++)
+            table.push_back(SymbolTable::Instance().Intern(name));
+        return &table;
+    }
 
-        vector<WorkLog> &logs = logDetails->GetAllEntries();
-        vector<WorkLog> filteredLogs;
+    /**
+     * @brief Checks the header and verifies every block's checksum.
+     */
+    static Image Scan(const MappedFile &file)
+    {
+        if (!file.IsOpen())
+            return Image();
+        return Scan(file.Data(), file.Size());
+    }
 
-        for (const auto &log : logs)
+    /**
+     * @brief Scan over one file image held at data, e.g. a slice of a larger file.
+     */
+    static Image Scan(const char *data, size_t size)
+    {
+        Image img;
+        if (size == 0)
+            return img;
+        if (size < HEADER_SIZE || memcmp(data, "SDAT", 4) != 0)
         {
-            if (IsDateInWeek(log.GetActualTiming().GetDate(), weekInput))
-                filteredLogs.push_back(log);
+            img.version = LEGACY_VERSION;
+            return img;
         }
 
-        if (filteredLogs.empty())
-        {
-            cout << "No entries found.\n";
-            return;
-        }
+        ByteReader in(data, size);
+        in.Skip(4);
+        in.ReadUInt32(img.version);
+        if (!IsBlocked(img.version))
+            return img;
 
-        cout << left << setw(8) << "LabID" << setw(12) << "Section" << setw(15) << "Date" << "Status" << endl;
-        for (const auto &log : filteredLogs)
+        while (in.Remaining() > 0)
         {
-            cout << left << setw(8) << log.GetLabId() << setw(12) << log.GetSectionName()
-                 << setw(15) << log.GetActualTiming().GetDate()
-                 << (log.GetIsLeave() ? "LEAVE" : "PRESENT") << endl;
+            uint32_t len, crc;
+            if (!in.ReadUInt32(len) || !in.ReadUInt32(crc) || len > in.Remaining())
+            {
+                img.truncated = true;
+                break;
+            }
+            const char *payload = in.Position();
+            in.Skip(len);
+
+            ByteReader head(payload, len);
+            Block b;
+            b.nameCount = -1;
+            bool ok = Crc32c::Compute(payload, len) == crc && head.ReadInt(b.kind) && head.ReadInt(b.count);
+            if (ok && img.version >= NAME_TABLE_VERSION)
+            {
+                ok = head.ReadInt(b.nameCount) && b.nameCount >= 0;
+                b.names = head.Position();
+                for (int i = 0; ok && i < b.nameCount; i++)
+                    ok = head.SkipString();
+            }
+            if (!ok)
+            {
+                img.corruptBlocks++;
+                img.corruptBytes += len;
+                continue;
+            }
+            b.data = head.Position();
+            b.size = head.Remaining();
+            img.blocks.push_back(b);
         }
+        return img;
     }
+};
 
-    void GenerateLabSpecificTimeSheet(LabDetails *lDetails, WorkLogDetails *logDetails)
+/**
+ * @class DiskIO
+ * @brief Durable file helpers used by the snapshot and journal code.
+ */
+class DiskIO
+{
+public:
+    /**
+     * @brief Forces buffered data for an open file down to the storage device.
+     */
+    static bool Sync(FILE *f)
     {
-        int labId;
-        cout << "Enter Lab ID: ";
-        InputOutput::SafeReadInt(labId);
-        if (!lDetails->FindLab(labId))
-        {
-            cout << "Error: Lab ID not found.\n";
-            return;
-        }
+        if (fflush(f) != 0)
+            return false;
+#ifdef _WIN32
+        return _commit(_fileno(f)) == 0;
+#else
+        return fsync(fileno(f)) == 0;
+#endif
+    }
 
-        vector<WorkLog> &logs = logDetails->GetAllEntries();
-        vector<WorkLog> labLogs;
-        for (const auto &log : logs)
-            if (log.GetLabId() == labId)
-                labLogs.push_back(log);
+    /**
+     * @brief Cuts an open file back to its first size bytes.
+     */
+    static bool Truncate(FILE *f, long size)
+    {
+        fflush(f);
+        clearerr(f);
+#ifdef _WIN32
+        return _chsize(_fileno(f), size) == 0;
+#else
+        return ftruncate(fileno(f), static_cast<off_t>(size)) == 0;
+#endif
+    }
 
-        if (labLogs.empty())
-        {
-            cout << "No logs for this lab.\n";
-            return;
-        }
+    /**
+     * @brief Writes a complete file and syncs it before returning.
+     */
+    static bool WriteDurably(const string &path, const string &bytes)
+    {
+        FILE *f = fopen(path.c_str(), "wb");
+        if (!f)
+            return false;
+        bool ok = bytes.empty() || fwrite(bytes.data(), 1, bytes.size(), f) == bytes.size();
+        ok = Sync(f) && ok;
+        return fclose(f) == 0 && ok;
+    }
 
-        cout << "Logs for Lab " << labId << ":\n";
-        for (const auto &log : labLogs)
-        {
-            cout << "Sec: " << log.GetSectionName() << " | Date: " << log.GetActualTiming().GetDate()
-                 << " | " << (log.GetIsLeave() ? "LEAVE" : "PRESENT") << endl;
-        }
+    /**
+     * @brief Atomically replaces dst with src (best effort on Windows).
+     */
+    static bool Replace(const string &src, const string &dst)
+    {
+#ifdef _WIN32
+        remove(dst.c_str());
+#endif
+        return rename(src.c_str(), dst.c_str()) == 0;
     }
 
-public:
-    HOD() : Person("HOD") {}
-    void ShowMenu(LabDetails *lDetails, WorkLogDetails *wDetails)
+    /**
+     * @brief Copies src over dst and syncs the copy, e.g. to keep a damaged file before it is rewritten.
+     */
+    static bool Copy(const string &src, const string &dst)
     {
-        int choice;
-        while (true)
-        {
-            cout << "\n--- HOD DASHBOARD ---\n";
-            cout << "1. Weekly Schedule\n2. Weekly Time Sheet Report\n3. Lab Specific Report\n4. Logout\nSelect: ";
-            InputOutput::SafeReadInt(choice);
-            if (choice == 1)
-                GenerateCompleteWeeklySchedule(lDetails);
-            else if (choice == 2)
-                GenerateWeeklyTimeSheetReport(lDetails, wDetails);
-            else if (choice == 3)
-                GenerateLabSpecificTimeSheet(lDetails, wDetails);
-            else
-                return;
-        }
+        FILE *in = fopen(src.c_str(), "rb");
+        if (!in)
+            return false;
+        string bytes;
+        char buf[1 << 16];
+        size_t n;
+        while ((n = fread(buf, 1, sizeof(buf), in)) > 0)
+            bytes.append(buf, n);
+        bool ok = !ferror(in);
+        fclose(in);
+        return ok && WriteDurably(dst, bytes);
+    }
+
+    static bool Exists(const string &path)
+    {
+        FILE *f = fopen(path.c_str(), "rb");
+        if (!f)
+            return false;
+        fclose(f);
+        return true;
     }
 };
 
-class AcademicOfficer : public Person
+// ==========================================
+// CORE DOMAIN ENTITIES
+// ==========================================
+
+/**
+ * @class DateAndTime
+ * @brief Encapsulates scheduling timing information in a packed 8-byte form.
+ * * Strings are parsed once when set (input or load) and only re-rendered for display
+ * or persistence. The day is either a concrete date (days since 1970-01-01) or a
+ * weekly slot encoded as -1 (Monday) .. -7 (Sunday).
+ */
+class DateAndTime
 {
+public:
+    static const int32_t NO_DAY = INT32_MIN;
+    static const uint16_t NO_TIME = 0xFFFF;
+
 private:
+    int32_t day;          // Day number, weekly slot, or NO_DAY
+    uint16_t startMinute; // Minutes since midnight, or NO_TIME
+    uint16_t endMinute;
+
+public:
+    DateAndTime() : day(NO_DAY), startMinute(NO_TIME), endMinute(NO_TIME) {}
+
+    void Set(const string &d, const string &s, const string &e)
+    {
+        SetDate(d);
+        SetStartTime(s);
+        SetEndTime(e);
+    }
+    void SetPacked(int32_t d, uint16_t s, uint16_t e)
+    {
+        day = d;
+        startMinute = s;
+        endMinute = e;
+    }
+    void SetDate(const string &d) { day = ParseDay(d); }
+    void SetDay(int32_t d) { day = d; }
+    void SetStartTime(const string &s) { startMinute = ParseMinutes(s); }
+    void SetEndTime(const string &e) { endMinute = ParseMinutes(e); }
+
+    // Cheap packed accessors for hot paths
+    int32_t GetDay() const { return day; }
+    uint16_t GetStartMinute() const { return startMinute; }
+    uint16_t GetEndMinute() const { return endMinute; }
+    bool IsWeekly() const { return day < 0 && day >= -7; }
+    bool HasTimes() const { return startMinute != NO_TIME && endMinute != NO_TIME; }
+
     /**
-     * @brief Deserializes makeup requests from disk.
-     * Reconstruction requires linking the Lab ID back to the live Lab object.
+     * @brief Length of the slot in minutes (0 if times are unset).
      */
-    vector<MakeupLabRequest> ReadMakeupRequestsFromBinary(LabDetails *lDetails)
+    int GetDurationMinutes() const
     {
-        vector<MakeupLabRequest> requests;
-        ifstream in("makeup_requests.dat", ios::binary);
-        if (!in.is_open())
-            return requests;
-
-        while (in.peek() != EOF)
-        {
-            MakeupLabRequest request;
-            int labId;
-            in.read(reinterpret_cast<char *>(&labId), sizeof(int));
-            if (in.eof())
-                break;
-
-            request.SetLab(lDetails->FindLab(labId));
+        return HasTimes() ? static_cast<int>(endMinute) - static_cast<int>(startMinute) : 0;
+    }
 
-            int secLen;
-            in.read(reinterpret_cast<char *>(&secLen), sizeof(int));
-            if (in.eof())
-                break;
-            char *secBuf = new char[secLen + 1];
-            in.read(secBuf, secLen);
-            secBuf[secLen] = '\0';
-            request.SetSectionName(string(secBuf));
-            delete[] secBuf;
-
-            int dateLen;
-            in.read(reinterpret_cast<char *>(&dateLen), sizeof(int));
-            if (in.eof())
-                break;
-            char *dateBuf = new char[dateLen + 1];
-            in.read(dateBuf, dateLen);
-            dateBuf[dateLen] = '\0';
-            request.SetRequestedDate(string(dateBuf));
-            delete[] dateBuf;
-
-            int startLen;
-            in.read(reinterpret_cast<char *>(&startLen), sizeof(int));
-            if (in.eof())
-                break;
-            char *startBuf = new char[startLen + 1];
-            in.read(startBuf, startLen);
-            startBuf[startLen] = '\0';
-            request.SetRequestedStartTime(string(startBuf));
-            delete[] startBuf;
-
-            int endLen;
-            in.read(reinterpret_cast<char *>(&endLen), sizeof(int));
-            if (in.eof())
-                break;
-            char *endBuf = new char[endLen + 1];
-            in.read(endBuf, endLen);
-            endBuf[endLen] = '\0';
-            request.SetRequestedEndTime(string(endBuf));
-            delete[] endBuf;
+    /**
+     * @brief Weekday of the slot: 0 = Monday .. 6 = Sunday, -1 if unknown.
+     */
+    int GetWeekday() const { return WeekdayOf(day); }
 
-            requests.push_back(request);
-        }
-        in.close();
-        return requests;
+    /**
+     * @brief Total order on (day, start, end) as a single integer compare.
+     */
+    uint64_t GetSortKey() const
+    {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(day) ^ 0x80000000u) << 32) |
+               (static_cast<uint64_t>(startMinute) << 16) | endMinute;
     }
+    bool operator<(const DateAndTime &o) const { return GetSortKey() < o.GetSortKey(); }
+    bool operator==(const DateAndTime &o) const { return GetSortKey() == o.GetSortKey(); }
 
     /**
-     * @brief Serializes current makeup requests to disk.
+     * @brief True if both slots are on the same day and their times intersect.
      */
-    void WriteMakeupRequestsToBinary(const vector<MakeupLabRequest> &requests)
+    bool Overlaps(const DateAndTime &o) const
     {
-        ofstream out("makeup_requests.dat", ios::binary | ios::trunc);
-        if (!out.is_open())
-            return;
+        return (day == o.day) & (startMinute < o.endMinute) & (o.startMinute < endMinute);
+    }
 
-        for (const auto &request : requests)
-        {
-            int labId = (request.GetLab() ? request.GetLab()->GetLabId() : -1);
-            out.write(reinterpret_cast<const char *>(&labId), sizeof(int));
+    // Rendered forms used for display and persistence
+    string GetDate() const { return FormatDay(day); }
+    string GetStartTime() const { return FormatMinutes(startMinute); }
+    string GetEndTime() const { return FormatMinutes(endMinute); }
 
-            string secName = request.GetSectionName();
-            int secLen = secName.length();
-            out.write(reinterpret_cast<const char *>(&secLen), sizeof(int));
-            out.write(secName.c_str(), secLen);
+    /**
+     * @brief Days since 1970-01-01 for a proleptic Gregorian date.
+     */
+    static int32_t DaysFromCivil(int y, int m, int d)
+    {
+        y -= m <= 2;
+        int era = (y >= 0 ? y : y - 399) / 400;
+        int yoe = y - era * 400;
+        int doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+        int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+        return era * 146097 + doe - 719468;
+    }
 
-            string date = request.GetRequestedDate();
-            int dateLen = date.length();
-            out.write(reinterpret_cast<const char *>(&dateLen), sizeof(int));
-            out.write(date.c_str(), dateLen);
+    static void CivilFromDays(int32_t z, int &y, int &m, int &d)
+    {
+        z += 719468;
+        int era = (z >= 0 ? z : z - 146096) / 146097;
+        int doe = z - era * 146097;
+        int yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+        int doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+        int mp = (5 * doy + 2) / 153;
+        d = doy - (153 * mp + 2) / 5 + 1;
+        m = mp + (mp < 10 ? 3 : -9);
+        y = yoe + era * 400 + (m <= 2);
+    }
 
-            string start = request.GetRequestedStartTime();
-            int startLen = start.length();
-            out.write(reinterpret_cast<const char *>(&startLen), sizeof(int));
-            out.write(start.c_str(), startLen);
+    /**
+     * @brief Weekday of a packed day: 0 = Monday .. 6 = Sunday, -1 if unknown.
+     */
+    static int WeekdayOf(int32_t day)
+    {
+        if (day < 0 && day >= -7)
+            return -day - 1;
+        if (day == NO_DAY)
+            return -1;
+        // 1970-01-01 was a Thursday (index 3)
+        return static_cast<int>(((day % 7) + 7 + 3) % 7);
+    }
 
-            string end = request.GetRequestedEndTime();
-            int endLen = end.length();
-            out.write(reinterpret_cast<const char *>(&endLen), sizeof(int));
-            out.write(end.c_str(), endLen);
-        }
-        out.close();
+    /**
+     * @brief Today's day number (UTC).
+     */
+    static int32_t Today()
+    {
+        time_t now = time(nullptr);
+        return static_cast<int32_t>(now / 86400 - (now % 86400 < 0));
     }
 
-public:
-    AcademicOfficer() : Person("Academic Officer") {}
+    static int32_t ParseDay(const string &s)
+    {
+        int y, m, d;
+        if (DataValidator::ParseDate(s, y, m, d))
+            return DaysFromCivil(y, m, d);
+        int wd = DataValidator::ParseWeekday(s);
+        return wd >= 0 ? -(wd + 1) : NO_DAY;
+    }
 
-    void AddBuilding(VenueDetails *vDetails)
+    static uint16_t ParseMinutes(const string &s)
     {
-        int id;
-        string name;
+        int m = DataValidator::ParseTime(s);
+        return m >= 0 ? static_cast<uint16_t>(m) : NO_TIME;
+    }
+
+    static string FormatDay(int32_t day)
+    {
+        static const char *names[] = {"Monday", "Tuesday", "Wednesday", "Thursday", "Friday", "Saturday", "Sunday"};
+        if (day == NO_DAY)
+            return "";
+        if (day < 0 && day >= -7)
+            return names[-day - 1];
+
+        int y, m, d;
+        CivilFromDays(day, y, m, d);
+        char buf[32];
+        snprintf(buf, sizeof(buf), "%04d-%02d-%02d", y, m, d);
+        return buf;
+    }
+
+    static string FormatMinutes(uint16_t minute)
+    {
+        if (minute == NO_TIME)
+            return "";
+        char buf[16];
+        snprintf(buf, sizeof(buf), "%02d:%02d", minute / 60, minute % 60);
+        return buf;
+    }
+};
+
+/**
+ * @class Recurrence
+ * @brief When a slot meets, beyond its packed day.
+ * * A dated slot meets once. A weekly slot meets on its weekday every week, or,
+ * with a term set, only on those weekdays within [from, to] that are not listed
+ * as exceptions. The text form extends the Day/Date field and is what gets
+ * persisted:
+ *   2024-03-06
+ *   Monday
+ *   Monday 2024-01-08..2024-05-10 except 2024-03-11 2024-03-18
+ * Occurrences are never materialised; callers expand them over a window.
+ */
+class Recurrence
+{
+private:
+    int32_t termFrom;           // inclusive; NO_DAY if the weekly slot is unbounded
+    int32_t termTo;             // inclusive
+    vector<int32_t> exceptions; // sorted dates on which the slot is skipped
+
+    static bool IsDate(int32_t day) { return day >= 0; }
+
+    static vector<string> Tokens(const string &text)
+    {
+        vector<string> out;
+        size_t pos = 0;
+        while (pos < text.size())
+        {
+            size_t from = text.find_first_not_of(' ', pos);
+            if (from == string::npos)
+                break;
+            pos = text.find(' ', from);
+            out.push_back(text.substr(from, pos == string::npos ? string::npos : pos - from));
+        }
+        return out;
+    }
+
+public:
+    Recurrence() : termFrom(DateAndTime::NO_DAY), termTo(DateAndTime::NO_DAY) {}
+
+    bool HasTerm() const { return termFrom != DateAndTime::NO_DAY; }
+    int32_t GetTermFrom() const { return termFrom; }
+    int32_t GetTermTo() const { return termTo; }
+    const vector<int32_t> &GetExceptions() const { return exceptions; }
+    bool IsEmpty() const { return !HasTerm() && exceptions.empty(); }
+
+    /**
+     * @brief True if a slot on 'slotDay' (a date or a weekly day) meets on 'date'.
+     */
+    bool OccursOn(int32_t slotDay, int32_t date) const
+    {
+        if (IsDate(slotDay))
+            return slotDay == date;
+        if (!IsDate(date) || DateAndTime::WeekdayOf(slotDay) != DateAndTime::WeekdayOf(date))
+            return false;
+        if (HasTerm() && (date < termFrom || date > termTo))
+            return false;
+        return !binary_search(exceptions.begin(), exceptions.end(), date);
+    }
+
+    /**
+     * @brief Visits the dates in [fromDay, toDay] the slot meets on, in order.
+     * Stops early when 'visit' returns false.
+     */
+    template <typename Visit>
+    void ForEachOccurrence(int32_t slotDay, int32_t fromDay, int32_t toDay, Visit visit) const
+    {
+        if (IsDate(slotDay))
+        {
+            if (slotDay >= fromDay && slotDay <= toDay)
+                visit(slotDay);
+            return;
+        }
+        if (HasTerm())
+        {
+            fromDay = max(fromDay, termFrom);
+            toDay = min(toDay, termTo);
+        }
+        fromDay = max(fromDay, 0);
+        toDay = min(toDay, INT32_MAX - 7);
+        if (fromDay > toDay || slotDay == DateAndTime::NO_DAY)
+            return;
+
+        int32_t date = fromDay + (DateAndTime::WeekdayOf(slotDay) - DateAndTime::WeekdayOf(fromDay) + 7) % 7;
+        auto skip = lower_bound(exceptions.begin(), exceptions.end(), date);
+        for (; date <= toDay; date += 7)
+        {
+            while (skip != exceptions.end() && *skip < date)
+                ++skip;
+            if (skip != exceptions.end() && *skip == date)
+                continue;
+            if (!visit(date))
+                return;
+        }
+    }
+
+    /**
+     * @brief True if the two slots meet on at least one common date.
+     */
+    static bool ShareDate(int32_t dayA, const Recurrence &a, int32_t dayB, const Recurrence &b)
+    {
+        if (IsDate(dayA))
+            return b.OccursOn(dayB, dayA);
+        if (IsDate(dayB))
+            return a.OccursOn(dayA, dayB);
+        if (dayA != dayB)
+            return false;
+        if (!a.HasTerm() && !b.HasTerm() && a.exceptions.empty() && b.exceptions.empty())
+            return true;
+
+        // Walk A's meetings over the overlap of both terms; exceptions are sparse,
+        // so this normally stops at the first or second candidate
+        int32_t from = max(a.HasTerm() ? a.termFrom : 0, b.HasTerm() ? b.termFrom : 0);
+        int32_t to = min(a.HasTerm() ? a.termTo : INT32_MAX, b.HasTerm() ? b.termTo : INT32_MAX);
+        bool shared = false;
+        a.ForEachOccurrence(dayA, from, to, [&](int32_t date)
+                            { shared = b.OccursOn(dayB, date);
+                              return !shared; });
+        return shared;
+    }
+
+    string Format(int32_t slotDay) const
+    {
+        string out = DateAndTime::FormatDay(slotDay);
+        if (HasTerm())
+            out += " " + DateAndTime::FormatDay(termFrom) + ".." + DateAndTime::FormatDay(termTo);
+        if (!exceptions.empty())
+        {
+            out += " except";
+            for (int32_t d : exceptions)
+                out += " " + DateAndTime::FormatDay(d);
+        }
+        return out;
+    }
+
+    /**
+     * @brief Parses the text form into the slot's packed day and its rule.
+     * @return false unless the text is a date, a weekday, or a weekday with a
+     * valid term and exceptions that fall on meeting days.
+     */
+    static bool Parse(const string &text, int32_t &slotDay, Recurrence &out)
+    {
+        out = Recurrence();
+        vector<string> tokens = Tokens(text);
+        if (tokens.empty())
+            return false;
+        slotDay = DateAndTime::ParseDay(tokens[0]);
+        if (slotDay == DateAndTime::NO_DAY)
+            return false;
+
+        size_t i = 1;
+        if (i < tokens.size() && tokens[i].find("..") != string::npos)
+        {
+            size_t dots = tokens[i].find("..");
+            int32_t from = DateAndTime::ParseDay(tokens[i].substr(0, dots));
+            int32_t to = DateAndTime::ParseDay(tokens[i].substr(dots + 2));
+            if (IsDate(slotDay) || !IsDate(from) || !IsDate(to) || from > to)
+                return false;
+            out.termFrom = from;
+            out.termTo = to;
+            i++;
+        }
+        if (i == tokens.size())
+            return true;
+
+        string keyword = tokens[i];
+        transform(keyword.begin(), keyword.end(), keyword.begin(), ::tolower);
+        if (keyword != "except" || IsDate(slotDay) || i + 1 == tokens.size())
+            return false;
+        for (i++; i < tokens.size(); i++)
+        {
+            int32_t d = DateAndTime::ParseDay(tokens[i]);
+            if (!out.OccursOn(slotDay, d))
+                return false; // not a meeting day, or listed twice
+            out.exceptions.insert(lower_bound(out.exceptions.begin(), out.exceptions.end(), d), d);
+        }
+        return true;
+    }
+};
+
+class CampusBlock
+{
+private:
+    int buildingId;
+    SymbolId nameId;
+
+public:
+    CampusBlock() : buildingId(0), nameId(0) {}
+    CampusBlock(int id, const string &n) : buildingId(id), nameId(SymbolTable::Instance().Intern(n)) {}
+    CampusBlock(int id, SymbolId n) : buildingId(id), nameId(n) {}
+
+    int GetId() const { return buildingId; }
+    const string &GetName() const { return SymbolTable::Instance().Name(nameId); }
+    SymbolId GetNameId() const { return nameId; }
+};
+
+class LectureHall
+{
+private:
+    int roomId;
+    SymbolId roomNumberId;
+    int buildingId;
+    CampusBlock *building; // Pointer to the parent building object
+
+public:
+    LectureHall() : roomId(0), roomNumberId(0), buildingId(0), building(nullptr) {}
+    LectureHall(int id, const string &num, int bId, CampusBlock *bldg)
+        : roomId(id), roomNumberId(SymbolTable::Instance().Intern(num)), buildingId(bId), building(bldg) {}
+    LectureHall(int id, SymbolId num, int bId, CampusBlock *bldg)
+        : roomId(id), roomNumberId(num), buildingId(bId), building(bldg) {}
+
+    int GetId() const { return roomId; }
+    const string &GetRoomNumber() const { return SymbolTable::Instance().Name(roomNumberId); }
+    SymbolId GetRoomNumberId() const { return roomNumberId; }
+    int GetBuildingId() const { return buildingId; }
+    CampusBlock *GetBuilding() const { return building; }
+
+    void SetBuilding(CampusBlock *b) { building = b; }
+};
+
+class UniversityTeacher
+{
+private:
+    int teacherId;
+    string name;
+
+public:
+    UniversityTeacher() : teacherId(0) {}
+    UniversityTeacher(int id, string n) : teacherId(id), name(n) {}
+
+    int GetId() const { return teacherId; }
+    string GetName() const { return name; }
+};
+
+class TeachingAssistant
+{
+private:
+    int taId;
+    string name;
+
+public:
+    TeachingAssistant() : taId(0) {}
+    TeachingAssistant(int id, string n) : taId(id), name(n) {}
+
+    int GetId() const { return taId; }
+    string GetName() const { return name; }
+};
+
+/**
+ * @class ClassSection
+ * @brief Represents a specific scheduled instance of a course.
+ * Links Teachers, TAs, Rooms, and Times.
+ */
+class ClassSection
+{
+private:
+    SymbolId sectionId;
+    UniversityTeacher *teacher;
+    vector<TeachingAssistant *> assistants;
+    CampusBlock *building;
+    LectureHall *room;
+    DateAndTime scheduleTime;
+    Recurrence recurrence;
+    SymbolId unparsedDayId; // stored Day/Date text that does not parse; 0 if none
+
+public:
+    ClassSection() : sectionId(0), teacher(nullptr), building(nullptr), room(nullptr), unparsedDayId(0) {}
+
+    void SetDetails(const string &name, UniversityTeacher *t, CampusBlock *b, LectureHall *r)
+    {
+        sectionId = SymbolTable::Instance().Intern(name);
+        teacher = t;
+        building = b;
+        room = r;
+    }
+
+    void AddTA(TeachingAssistant *ta)
+    {
+        assistants.push_back(ta);
+    }
+
+    // Getters
+    const string &GetSectionName() const { return SymbolTable::Instance().Name(sectionId); }
+    SymbolId GetSectionId() const { return sectionId; }
+    UniversityTeacher *GetTeacher() const { return teacher; }
+    const vector<TeachingAssistant *> &GetAssistants() const { return assistants; }
+    CampusBlock *GetBuilding() const { return building; }
+    LectureHall *GetRoom() const { return room; }
+    DateAndTime &GetScheduleTime() { return scheduleTime; }
+    const DateAndTime &GetScheduleTime() const { return scheduleTime; }
+    Recurrence &GetRecurrence() { return recurrence; }
+    const Recurrence &GetRecurrence() const { return recurrence; }
+
+    /**
+     * @brief The Day/Date text including any term and exceptions (see Recurrence).
+     * A stored value that never parsed is returned as it was written.
+     */
+    string GetDayText() const
+    {
+        if (unparsedDayId != 0 && scheduleTime.GetDay() == DateAndTime::NO_DAY)
+            return SymbolTable::Instance().Name(unparsedDayId);
+        return recurrence.Format(scheduleTime.GetDay());
+    }
+
+    /**
+     * @brief Sets the meeting day and rule from Day/Date text.
+     * @return false (leaving the section unchanged) if the text does not parse.
+     */
+    bool SetDayText(const string &text)
+    {
+        int32_t day;
+        Recurrence rule;
+        if (!Recurrence::Parse(text, day, rule))
+            return false;
+        scheduleTime.SetDay(day);
+        recurrence = std::move(rule);
+        unparsedDayId = 0;
+        return true;
+    }
+
+    /**
+     * @brief SetDayText for persisted data. Older files hold free text (e.g. "Mon/Wed");
+     * text that does not parse leaves the day unset but is kept and written back verbatim.
+     */
+    void RestoreDayText(const string &text)
+    {
+        if (SetDayText(text))
+            return;
+        scheduleTime.SetDay(DateAndTime::NO_DAY);
+        recurrence = Recurrence();
+        unparsedDayId = SymbolTable::Instance().Intern(text);
+    }
+
+    // Setters used for data loading reconstruction
+    void SetSectionName(const string &n) { sectionId = SymbolTable::Instance().Intern(n); }
+    void SetSectionId(SymbolId id) { sectionId = id; }
+    void SetTeacher(UniversityTeacher *t) { teacher = t; }
+    void SetBuilding(CampusBlock *b) { building = b; }
+    void SetRoom(LectureHall *r) { room = r; }
+};
+
+class CourseLaboratory
+{
+private:
+    int labId;
+    SymbolId courseCodeId;
+    vector<ClassSection> sections;
+
+public:
+    CourseLaboratory() : labId(0), courseCodeId(0) {}
+
+    void AddSection(const ClassSection &s)
+    {
+        sections.push_back(s);
+    }
+
+    const ClassSection *FindSection(SymbolId secId) const
+    {
+        for (const auto &s : sections)
+        {
+            if (s.GetSectionId() == secId)
+                return &s;
+        }
+        return nullptr;
+    }
+
+    const ClassSection *FindSection(const string &secName) const
+    {
+        // A name that was never interned cannot belong to any section
+        SymbolId id;
+        return SymbolTable::Instance().Find(secName, id) ? FindSection(id) : nullptr;
+    }
+
+    ClassSection *FindSection(SymbolId secId)
+    {
+        return const_cast<ClassSection *>(static_cast<const CourseLaboratory &>(*this).FindSection(secId));
+    }
+
+    ClassSection *FindSection(const string &secName)
+    {
+        return const_cast<ClassSection *>(static_cast<const CourseLaboratory &>(*this).FindSection(secName));
+    }
+
+    int GetLabId() const { return labId; }
+    void SetLabId(int id) { labId = id; }
+    const string &GetCourseCode() const { return SymbolTable::Instance().Name(courseCodeId); }
+    void SetCourseCode(const string &code) { courseCodeId = SymbolTable::Instance().Intern(code); }
+    SymbolId GetCourseCodeId() const { return courseCodeId; }
+    void SetCourseCodeId(SymbolId id) { courseCodeId = id; }
+    vector<ClassSection> &GetSections() { return sections; }
+    const vector<ClassSection> &GetSections() const { return sections; }
+};
+
+class WorkLog
+{
+private:
+    int labId;
+    SymbolId sectionId;
+    DateAndTime actualTiming;
+    bool isLeave;
+
+public:
+    WorkLog() : labId(0), sectionId(0), isLeave(false) {}
+
+    int GetLabId() const { return labId; }
+    void SetLabId(int id) { labId = id; }
+    const string &GetSectionName() const { return SymbolTable::Instance().Name(sectionId); }
+    void SetSectionName(const string &n) { sectionId = SymbolTable::Instance().Intern(n); }
+    SymbolId GetSectionId() const { return sectionId; }
+    void SetSectionId(SymbolId id) { sectionId = id; }
+    const DateAndTime &GetActualTiming() const { return actualTiming; }
+    DateAndTime &GetActualTiming() { return actualTiming; }
+    bool GetIsLeave() const { return isLeave; }
+    void SetIsLeave(bool l) { isLeave = l; }
+};
+
+class MakeupLabRequest
+{
+private:
+    CourseLaboratory *lab;
+    SymbolId sectionId;
+    DateAndTime requestedTiming;
+
+public:
+    MakeupLabRequest() : lab(nullptr), sectionId(0) {}
+    MakeupLabRequest(CourseLaboratory *l, const string &sec, const string &date, const string &start, const string &end)
+        : lab(l), sectionId(SymbolTable::Instance().Intern(sec))
+    {
+        requestedTiming.Set(date, start, end);
+    }
+
+    CourseLaboratory *GetLab() const { return lab; }
+    void SetLab(CourseLaboratory *l) { lab = l; }
+    const string &GetSectionName() const { return SymbolTable::Instance().Name(sectionId); }
+    void SetSectionName(const string &s) { sectionId = SymbolTable::Instance().Intern(s); }
+    SymbolId GetSectionId() const { return sectionId; }
+    const DateAndTime &GetRequestedTiming() const { return requestedTiming; }
+    string GetRequestedDate() const { return requestedTiming.GetDate(); }
+    void SetRequestedDate(const string &d) { requestedTiming.SetDate(d); }
+    string GetRequestedStartTime() const { return requestedTiming.GetStartTime(); }
+    void SetRequestedStartTime(const string &s) { requestedTiming.SetStartTime(s); }
+    string GetRequestedEndTime() const { return requestedTiming.GetEndTime(); }
+    void SetRequestedEndTime(const string &e) { requestedTiming.SetEndTime(e); }
+};
+
+// ==========================================
+// DETAILS INTERFACES & IMPLEMENTATIONS
+// ==========================================
+
+/**
+ * @class ScheduleObserver
+ * @brief Notified whenever a section is committed to the lab store.
+ * * Lets indices over the schedule stay in sync without re-walking every lab.
+ */
+class ScheduleObserver
+{
+public:
+    virtual void OnSectionAdded(const CourseLaboratory &lab, const ClassSection &sec) = 0;
+    /**
+     * @brief A lab was appended to the store at position 'slot' (store order), before its sections are reported.
+     */
+    virtual void OnLabAdded(const CourseLaboratory &, size_t) {}
+    virtual ~ScheduleObserver() {}
+};
+
+/**
+ * @class WriteBatch
+ * @brief Brackets a bulk mutation so the persistence layer can group its syncs.
+ */
+class WriteBatch
+{
+public:
+    virtual void BeginBatch() = 0;
+    virtual void EndBatch() = 0;
+    virtual ~WriteBatch() {}
+};
+
+/**
+ * The mutators below return false when the change could not be recorded
+ * (e.g. the journal write failed); the store is left unchanged in that case.
+ */
+class LabDetails
+{
+public:
+    virtual bool AddLab(const CourseLaboratory &l) = 0;
+    virtual bool UpdateLab(const CourseLaboratory &l) = 0;
+    /**
+     * @brief Appends a section to a lab, creating the lab if it does not exist yet.
+     * This is the single commit point for new sections; observers are notified here.
+     */
+    virtual bool AddSection(int labId, const string &courseCode, const ClassSection &s) = 0;
+    virtual CourseLaboratory *FindLab(int id) = 0;
+    virtual deque<CourseLaboratory> &GetAllLabs() = 0;
+    virtual void AddObserver(ScheduleObserver *o) = 0;
+};
+
+/**
+ * @brief Per-lab attendance totals produced by WorkLogDetails::SummarizeByLab.
+ */
+struct LabLogSummary
+{
+    int labId;
+    size_t entries;
+    size_t leaves;
+    long presentMinutes;
+};
+
+class WorkLogDetails
+{
+public:
+    virtual bool AddEntry(const WorkLog &entry) = 0;
+    /**
+     * @brief Appends a batch of validated entries in order, as one store operation.
+     */
+    virtual bool AddEntries(const vector<WorkLog> &entries) = 0;
+    virtual size_t GetEntryCount() = 0;
+    /**
+     * @brief Visits every entry in insertion order.
+     */
+    virtual void ForEachEntry(const function<void(const WorkLog &)> &visit) = 0;
+    /**
+     * @brief Visits entries [fromRow, toRow) of insertion order; safe to call from several threads at once.
+     */
+    virtual void ForEachEntryInRows(size_t fromRow, size_t toRow, const function<void(const WorkLog &)> &visit) = 0;
+    /**
+     * @brief A [first, last) row range that holds every entry with day in [fromDay, toDay].
+     * It may hold other entries too; callers still filter by day.
+     */
+    virtual pair<size_t, size_t> RowSpanForDays(int32_t fromDay, int32_t toDay) = 0;
+    /**
+     * @brief Visits one lab's entries with day in [fromDay, toDay], in date order.
+     */
+    virtual void ForEachForLab(int labId, int32_t fromDay, int32_t toDay, const function<void(const WorkLog &)> &visit) = 0;
+    /**
+     * @brief Visits all entries with day in [fromDay, toDay], in date order.
+     */
+    virtual void ForEachInDateRange(int32_t fromDay, int32_t toDay, const function<void(const WorkLog &)> &visit) = 0;
+    /**
+     * @brief Entry count, leave count and present minutes for every lab with logs.
+     */
+    virtual vector<LabLogSummary> SummarizeByLab() = 0;
+};
+
+class VenueDetails
+{
+public:
+    virtual bool AddBuilding(const CampusBlock &b) = 0;
+    virtual bool AddRoom(const LectureHall &r) = 0;
+    virtual CampusBlock *FindBuilding(int id) = 0;
+    virtual LectureHall *FindRoom(int id) = 0;
+    virtual deque<CampusBlock> &GetAllBuildings() = 0;
+    virtual deque<LectureHall> &GetAllRooms() = 0;
+};
+
+class FacultyDetails
+{
+public:
+    virtual bool AddTeacher(const UniversityTeacher &t) = 0;
+    virtual bool AddTA(const TeachingAssistant &t) = 0;
+    virtual UniversityTeacher *FindTeacher(int id) = 0;
+    virtual TeachingAssistant *FindTA(int id) = 0;
+    virtual deque<UniversityTeacher> &GetAllTeachers() = 0;
+    virtual deque<TeachingAssistant> &GetAllTAs() = 0;
+};
+
+// In-Memory Implementations using STL vectors
+
+/**
+ * @class InMemoryLabDetails
+ * @brief Lab store with an ID -> slot hash index.
+ * * Labs live in a deque so that CourseLaboratory pointers held by sections
+ * and makeup requests stay valid when later labs are added.
+ */
+class InMemoryLabDetails : public LabDetails
+{
+    deque<CourseLaboratory> labs;
+    unordered_map<int, size_t> slotById; // Lab ID -> position in labs
+    vector<ScheduleObserver *> observers;
+
+public:
+    bool AddLab(const CourseLaboratory &l) override
+    {
+        // First lab with a given ID wins the index, matching the old linear FindLab
+        slotById.emplace(l.GetLabId(), labs.size());
+        labs.push_back(l);
+
+        const CourseLaboratory &stored = labs.back();
+        for (auto *o : observers)
+            o->OnLabAdded(stored, labs.size() - 1);
+        for (const auto &sec : stored.GetSections())
+            for (auto *o : observers)
+                o->OnSectionAdded(stored, sec);
+        return true;
+    }
+    bool AddSection(int labId, const string &courseCode, const ClassSection &s) override
+    {
+        CourseLaboratory *lab = FindLab(labId);
+        if (!lab)
+        {
+            CourseLaboratory newLab;
+            newLab.SetLabId(labId);
+            newLab.SetCourseCode(courseCode);
+            slotById.emplace(labId, labs.size());
+            labs.push_back(newLab);
+            lab = &labs.back();
+            for (auto *o : observers)
+                o->OnLabAdded(*lab, labs.size() - 1);
+        }
+        lab->AddSection(s);
+        for (auto *o : observers)
+            o->OnSectionAdded(*lab, lab->GetSections().back());
+        return true;
+    }
+    bool UpdateLab(const CourseLaboratory &l) override
+    {
+        CourseLaboratory *existing = FindLab(l.GetLabId());
+        if (existing && existing != &l)
+            *existing = l;
+        return true;
+    }
+    CourseLaboratory *FindLab(int id) override
+    {
+        auto it = slotById.find(id);
+        return it != slotById.end() ? &labs[it->second] : nullptr;
+    }
+    deque<CourseLaboratory> &GetAllLabs() override { return labs; }
+    void AddObserver(ScheduleObserver *o) override { observers.push_back(o); }
+};
+
+/**
+ * @class ColumnarWorkLogDetails
+ * @brief Struct-of-arrays log store.
+ * * Each WorkLog field lives in its own contiguous column: lab slot, interned
+ * section ID, day number, start/end minutes, and a leave bitset. Aggregations
+ * run as tight loops over these columns, which the compiler can vectorise.
+ * WorkLog objects are only materialised (into one reused scratch object) when a
+ * visitor asks for rows. Secondary indices on (lab ID, day) and on day keep
+ * report scans proportional to the matching rows.
+ */
+class ColumnarWorkLogDetails : public WorkLogDetails
+{
+    // Columns, one element per row
+    vector<uint32_t> labSlots; // dense index into labIds
+    vector<SymbolId> sectionIds;
+    vector<int32_t> days;
+    vector<uint16_t> startMinutes;
+    vector<uint16_t> endMinutes;
+    vector<uint64_t> leaveBits; // bit (row % 64) of word (row / 64)
+
+    // Dictionary for the dense lab column; section IDs come from SymbolTable
+    vector<int> labIds;
+    unordered_map<int, uint32_t> labSlotById;
+
+    map<pair<int, int32_t>, vector<uint32_t>> rowsByLabDay;
+    map<int32_t, vector<uint32_t>> rowsByDay;
+
+    uint32_t LabSlot(int labId)
+    {
+        auto it = labSlotById.find(labId);
+        if (it != labSlotById.end())
+            return it->second;
+        uint32_t slot = static_cast<uint32_t>(labIds.size());
+        labIds.push_back(labId);
+        labSlotById.emplace(labId, slot);
+        return slot;
+    }
+
+    bool IsLeave(size_t row) const { return (leaveBits[row >> 6] >> (row & 63)) & 1; }
+
+    /**
+     * @brief Fills a caller-owned row object, so concurrent readers never share state.
+     */
+    const WorkLog &Materialize(uint32_t row, WorkLog &out) const
+    {
+        out.SetLabId(labIds[labSlots[row]]);
+        out.SetSectionId(sectionIds[row]);
+        out.GetActualTiming().SetPacked(days[row], startMinutes[row], endMinutes[row]);
+        out.SetIsLeave(IsLeave(row));
+        return out;
+    }
+
+    void Append(const WorkLog &entry)
+    {
+        uint32_t row = static_cast<uint32_t>(days.size());
+        const DateAndTime &t = entry.GetActualTiming();
+
+        labSlots.push_back(LabSlot(entry.GetLabId()));
+        sectionIds.push_back(entry.GetSectionId());
+        days.push_back(t.GetDay());
+        startMinutes.push_back(t.GetStartMinute());
+        endMinutes.push_back(t.GetEndMinute());
+        if ((row & 63) == 0)
+            leaveBits.push_back(0);
+        leaveBits.back() |= static_cast<uint64_t>(entry.GetIsLeave()) << (row & 63);
+
+        rowsByLabDay[{entry.GetLabId(), t.GetDay()}].push_back(row);
+        rowsByDay[t.GetDay()].push_back(row);
+    }
+
+public:
+    bool AddEntry(const WorkLog &entry) override
+    {
+        Append(entry);
+        return true;
+    }
+
+    bool AddEntries(const vector<WorkLog> &entries) override
+    {
+        size_t rows = days.size() + entries.size();
+        labSlots.reserve(rows);
+        sectionIds.reserve(rows);
+        days.reserve(rows);
+        startMinutes.reserve(rows);
+        endMinutes.reserve(rows);
+        leaveBits.reserve((rows + 63) / 64);
+        for (const auto &entry : entries)
+            Append(entry);
+        return true;
+    }
+
+    size_t GetEntryCount() override { return days.size(); }
+
+    void ForEachEntry(const function<void(const WorkLog &)> &visit) override
+    {
+        WorkLog scratch;
+        for (uint32_t row = 0; row < days.size(); row++)
+            visit(Materialize(row, scratch));
+    }
+
+    void ForEachEntryInRows(size_t fromRow, size_t toRow, const function<void(const WorkLog &)> &visit) override
+    {
+        WorkLog scratch;
+        toRow = min(toRow, days.size());
+        for (size_t row = fromRow; row < toRow; row++)
+            visit(Materialize(static_cast<uint32_t>(row), scratch));
+    }
+
+    pair<size_t, size_t> RowSpanForDays(int32_t, int32_t) override { return {0, days.size()}; }
+
+    void ForEachForLab(int labId, int32_t fromDay, int32_t toDay, const function<void(const WorkLog &)> &visit) override
+    {
+        WorkLog scratch;
+        for (auto it = rowsByLabDay.lower_bound({labId, fromDay});
+             it != rowsByLabDay.end() && it->first.first == labId && it->first.second <= toDay; ++it)
+            for (uint32_t row : it->second)
+                visit(Materialize(row, scratch));
+    }
+
+    void ForEachInDateRange(int32_t fromDay, int32_t toDay, const function<void(const WorkLog &)> &visit) override
+    {
+        WorkLog scratch;
+        for (auto it = rowsByDay.lower_bound(fromDay); it != rowsByDay.end() && it->first <= toDay; ++it)
+            for (uint32_t row : it->second)
+                visit(Materialize(row, scratch));
+    }
+
+    vector<LabLogSummary> SummarizeByLab() override
+    {
+        size_t labs = labIds.size();
+        vector<size_t> entries(labs, 0), leaves(labs, 0);
+        vector<long> minutes(labs, 0);
+
+        size_t n = days.size();
+        int duration[64];
+        for (size_t base = 0; base < n; base += 64)
+        {
+            uint64_t leave = leaveBits[base >> 6];
+            size_t len = min<size_t>(64, n - base);
+
+            // Vectorisable pass over the time columns...
+            for (size_t i = 0; i < len; i++)
+            {
+                int dur = static_cast<int>(endMinutes[base + i]) - static_cast<int>(startMinutes[base + i]);
+                int keep = static_cast<int>(((leave >> i) & 1) ^ 1) & (startMinutes[base + i] != DateAndTime::NO_TIME);
+                duration[i] = dur * keep;
+            }
+            // ...then a scatter into the per-lab accumulators
+            for (size_t i = 0; i < len; i++)
+            {
+                uint32_t slot = labSlots[base + i];
+                entries[slot]++;
+                leaves[slot] += (leave >> i) & 1;
+                minutes[slot] += duration[i];
+            }
+        }
+
+        vector<LabLogSummary> out;
+        out.reserve(labs);
+        for (size_t slot = 0; slot < labs; slot++)
+            out.push_back({labIds[slot], entries[slot], leaves[slot], minutes[slot]});
+        sort(out.begin(), out.end(), [](const LabLogSummary &a, const LabLogSummary &b)
+             { return a.labId < b.labId; });
+        return out;
+    }
+};
+
+/**
+ * @class InMemoryVenueDetails
+ * @brief Venue store with hash indices on building and room IDs.
+ * * Deque storage keeps CampusBlock/LectureHall addresses stable, so the
+ * pointers cached in LectureHall::building and ClassSection never dangle.
+ */
+class InMemoryVenueDetails : public VenueDetails
+{
+    deque<CampusBlock> buildings;
+    deque<LectureHall> rooms;
+    unordered_map<int, size_t> buildingSlotById;
+    unordered_map<int, size_t> roomSlotById;
+
+public:
+    bool AddBuilding(const CampusBlock &b) override
+    {
+        buildingSlotById.emplace(b.GetId(), buildings.size());
+        buildings.push_back(b);
+        return true;
+    }
+    bool AddRoom(const LectureHall &r) override
+    {
+        roomSlotById.emplace(r.GetId(), rooms.size());
+        rooms.push_back(r);
+        return true;
+    }
+
+    CampusBlock *FindBuilding(int id) override
+    {
+        auto it = buildingSlotById.find(id);
+        return it != buildingSlotById.end() ? &buildings[it->second] : nullptr;
+    }
+    LectureHall *FindRoom(int id) override
+    {
+        auto it = roomSlotById.find(id);
+        return it != roomSlotById.end() ? &rooms[it->second] : nullptr;
+    }
+    deque<CampusBlock> &GetAllBuildings() override { return buildings; }
+    deque<LectureHall> &GetAllRooms() override { return rooms; }
+};
+
+/**
+ * @class InMemoryFacultyDetails
+ * @brief Faculty store with hash indices on teacher and TA IDs.
+ * * Uses the same stable deque storage as InMemoryVenueDetails so that
+ * ClassSection teacher/assistant pointers survive later inserts.
+ */
+class InMemoryFacultyDetails : public FacultyDetails
+{
+    deque<UniversityTeacher> teachers;
+    deque<TeachingAssistant> tas;
+    unordered_map<int, size_t> teacherSlotById;
+    unordered_map<int, size_t> taSlotById;
+
+public:
+    bool AddTeacher(const UniversityTeacher &t) override
+    {
+        teacherSlotById.emplace(t.GetId(), teachers.size());
+        teachers.push_back(t);
+        return true;
+    }
+    bool AddTA(const TeachingAssistant &t) override
+    {
+        taSlotById.emplace(t.GetId(), tas.size());
+        tas.push_back(t);
+        return true;
+    }
+
+    UniversityTeacher *FindTeacher(int id) override
+    {
+        auto it = teacherSlotById.find(id);
+        return it != teacherSlotById.end() ? &teachers[it->second] : nullptr;
+    }
+    TeachingAssistant *FindTA(int id) override
+    {
+        auto it = taSlotById.find(id);
+        return it != taSlotById.end() ? &tas[it->second] : nullptr;
+    }
+    deque<UniversityTeacher> &GetAllTeachers() override { return teachers; }
+    deque<TeachingAssistant> &GetAllTAs() override { return tas; }
+};
+
+// ==========================================
+// CONCURRENT ACCESS
+// ==========================================
+
+/**
+ * @brief Immutable view of the schedule handed to concurrent readers.
+ * * Labs are shared between successive snapshots: publishing after a write only
+ * copies the labs that changed, plus the vector of lab pointers.
+ */
+struct ScheduleSnapshot
+{
+    vector<shared_ptr<const CourseLaboratory>> labs; // store order
+    unordered_map<int, size_t> slotById;
+
+    const CourseLaboratory *FindLab(int id) const
+    {
+        auto it = slotById.find(id);
+        return it != slotById.end() ? labs[it->second].get() : nullptr;
+    }
+};
+
+/**
+ * @class ConcurrentLabDetails
+ * @brief Serializes schedule writers and gives readers RCU-style snapshots.
+ * * Writers take a mutex and record which labs they touched. Snapshot() folds
+ * those into a new ScheduleSnapshot and swaps it in atomically; if a writer
+ * currently holds the lock it returns the last published snapshot instead, so
+ * readers never wait for a writer. Pointers from FindLab/GetAllLabs refer to
+ * the live store, so only the thread that created this view may call them (it
+ * aborts otherwise); other threads read through Snapshot(). Mutations made
+ * through those pointers are not tracked.
+ */
+class ConcurrentLabDetails : public LabDetails
+{
+    LabDetails *inner;
+    const thread::id owner; // the only thread allowed to reach the live store
+    mutex writer;
+    shared_ptr<const ScheduleSnapshot> current; // read and replaced with atomic_load/atomic_store
+    vector<int> dirty;                          // labs changed since 'current' (guarded by writer)
+
+    void Republish()
+    {
+        if (dirty.empty())
+            return;
+        sort(dirty.begin(), dirty.end());
+        dirty.erase(unique(dirty.begin(), dirty.end()), dirty.end());
+
+        auto next = make_shared<ScheduleSnapshot>(*atomic_load(&current));
+        for (int id : dirty)
+        {
+            CourseLaboratory *lab = inner->FindLab(id);
+            if (!lab)
+                continue;
+            auto copy = make_shared<const CourseLaboratory>(*lab);
+            auto it = next->slotById.find(id);
+            if (it != next->slotById.end())
+                next->labs[it->second] = copy;
+            else
+            {
+                next->slotById.emplace(id, next->labs.size());
+                next->labs.push_back(copy);
+            }
+        }
+        dirty.clear();
+        atomic_store(&current, shared_ptr<const ScheduleSnapshot>(std::move(next)));
+    }
+
+    void RequireOwner(const char *method) const
+    {
+        if (this_thread::get_id() == owner)
+            return;
+        cerr << "ConcurrentLabDetails::" << method << " called off the owning thread; use Snapshot().\n";
+        abort();
+    }
+
+public:
+    explicit ConcurrentLabDetails(LabDetails *l)
+        : inner(l), owner(this_thread::get_id()), current(make_shared<ScheduleSnapshot>())
+    {
+        for (const auto &lab : inner->GetAllLabs())
+            dirty.push_back(lab.GetLabId());
+        Republish(); // otherwise a reader racing the first writer gets an empty schedule
+    }
+
+    shared_ptr<const ScheduleSnapshot> Snapshot()
+    {
+        unique_lock<mutex> lock(writer, try_to_lock);
+        if (lock.owns_lock())
+            Republish();
+        return atomic_load(&current);
+    }
+
+    bool AddLab(const CourseLaboratory &l) override
+    {
+        lock_guard<mutex> lock(writer);
+        if (!inner->AddLab(l))
+            return false;
+        dirty.push_back(l.GetLabId());
+        return true;
+    }
+    bool UpdateLab(const CourseLaboratory &l) override
+    {
+        lock_guard<mutex> lock(writer);
+        if (!inner->UpdateLab(l))
+            return false;
+        dirty.push_back(l.GetLabId());
+        return true;
+    }
+    bool AddSection(int labId, const string &courseCode, const ClassSection &s) override
+    {
+        lock_guard<mutex> lock(writer);
+        if (!inner->AddSection(labId, courseCode, s))
+            return false;
+        dirty.push_back(labId);
+        return true;
+    }
+    CourseLaboratory *FindLab(int id) override
+    {
+        RequireOwner("FindLab");
+        return inner->FindLab(id);
+    }
+    deque<CourseLaboratory> &GetAllLabs() override
+    {
+        RequireOwner("GetAllLabs");
+        return inner->GetAllLabs();
+    }
+    void AddObserver(ScheduleObserver *o) override
+    {
+        lock_guard<mutex> lock(writer);
+        inner->AddObserver(o);
+    }
+};
+
+/**
+ * @class ConcurrentVenueDetails
+ * @brief Readers-writer lock around a venue store.
+ * * Lookups share the lock and only wait while an insert updates the indices.
+ * Returned pointers stay valid (deque storage, entities are never modified).
+ * GetAll* exposes the live containers and is for single-threaded callers.
+ */
+class ConcurrentVenueDetails : public VenueDetails
+{
+    VenueDetails *inner;
+    shared_mutex rw;
+
+public:
+    explicit ConcurrentVenueDetails(VenueDetails *v) : inner(v) {}
+
+    bool AddBuilding(const CampusBlock &b) override
+    {
+        unique_lock<shared_mutex> lock(rw);
+        return inner->AddBuilding(b);
+    }
+    bool AddRoom(const LectureHall &r) override
+    {
+        unique_lock<shared_mutex> lock(rw);
+        return inner->AddRoom(r);
+    }
+    CampusBlock *FindBuilding(int id) override
+    {
+        shared_lock<shared_mutex> lock(rw);
+        return inner->FindBuilding(id);
+    }
+    LectureHall *FindRoom(int id) override
+    {
+        shared_lock<shared_mutex> lock(rw);
+        return inner->FindRoom(id);
+    }
+    deque<CampusBlock> &GetAllBuildings() override { return inner->GetAllBuildings(); }
+    deque<LectureHall> &GetAllRooms() override { return inner->GetAllRooms(); }
+};
+
+/**
+ * @class ConcurrentFacultyDetails
+ * @brief Readers-writer lock around a faculty store; same rules as ConcurrentVenueDetails.
+ */
+class ConcurrentFacultyDetails : public FacultyDetails
+{
+    FacultyDetails *inner;
+    shared_mutex rw;
+
+public:
+    explicit ConcurrentFacultyDetails(FacultyDetails *f) : inner(f) {}
+
+    bool AddTeacher(const UniversityTeacher &t) override
+    {
+        unique_lock<shared_mutex> lock(rw);
+        return inner->AddTeacher(t);
+    }
+    bool AddTA(const TeachingAssistant &t) override
+    {
+        unique_lock<shared_mutex> lock(rw);
+        return inner->AddTA(t);
+    }
+    UniversityTeacher *FindTeacher(int id) override
+    {
+        shared_lock<shared_mutex> lock(rw);
+        return inner->FindTeacher(id);
+    }
+    TeachingAssistant *FindTA(int id) override
+    {
+        shared_lock<shared_mutex> lock(rw);
+        return inner->FindTA(id);
+    }
+    deque<UniversityTeacher> &GetAllTeachers() override { return inner->GetAllTeachers(); }
+    deque<TeachingAssistant> &GetAllTAs() override { return inner->GetAllTAs(); }
+};
+
+/**
+ * @class ConcurrentWorkLogDetails
+ * @brief Lock-free attendance appends in front of a readers-writer locked log store.
+ * * AddEntry only pushes onto a LockFreeAppendList. Readers first fold any pending
+ * entries into the store under the exclusive lock (skipped when nothing is
+ * pending), then read under the shared lock, so reports run in parallel.
+ */
+class ConcurrentWorkLogDetails : public WorkLogDetails
+{
+    WorkLogDetails *inner;
+    LockFreeAppendList<WorkLog> pending;
+    shared_mutex rw;
+
+    void Publish()
+    {
+        if (pending.Empty())
+            return;
+        unique_lock<shared_mutex> lock(rw);
+        pending.Drain([this](const WorkLog &entry)
+                      { inner->AddEntry(entry); });
+    }
+
+public:
+    explicit ConcurrentWorkLogDetails(WorkLogDetails *w) : inner(w) {}
+
+    bool AddEntry(const WorkLog &entry) override
+    {
+        pending.Append(entry);
+        return true;
+    }
+
+    bool AddEntries(const vector<WorkLog> &entries) override
+    {
+        unique_lock<shared_mutex> lock(rw);
+        pending.Drain([this](const WorkLog &entry)
+                      { inner->AddEntry(entry); });
+        return inner->AddEntries(entries);
+    }
+
+    size_t GetEntryCount() override
+    {
+        Publish();
+        shared_lock<shared_mutex> lock(rw);
+        return inner->GetEntryCount();
+    }
+    void ForEachEntry(const function<void(const WorkLog &)> &visit) override
+    {
+        Publish();
+        shared_lock<shared_mutex> lock(rw);
+        inner->ForEachEntry(visit);
+    }
+    void ForEachEntryInRows(size_t fromRow, size_t toRow, const function<void(const WorkLog &)> &visit) override
+    {
+        Publish();
+        shared_lock<shared_mutex> lock(rw);
+        inner->ForEachEntryInRows(fromRow, toRow, visit);
+    }
+    pair<size_t, size_t> RowSpanForDays(int32_t fromDay, int32_t toDay) override
+    {
+        Publish();
+        shared_lock<shared_mutex> lock(rw);
+        return inner->RowSpanForDays(fromDay, toDay);
+    }
+    void ForEachForLab(int labId, int32_t fromDay, int32_t toDay, const function<void(const WorkLog &)> &visit) override
+    {
+        Publish();
+        shared_lock<shared_mutex> lock(rw);
+        inner->ForEachForLab(labId, fromDay, toDay, visit);
+    }
+    void ForEachInDateRange(int32_t fromDay, int32_t toDay, const function<void(const WorkLog &)> &visit) override
+    {
+        Publish();
+        shared_lock<shared_mutex> lock(rw);
+        inner->ForEachInDateRange(fromDay, toDay, visit);
+    }
+    vector<LabLogSummary> SummarizeByLab() override
+    {
+        Publish();
+        shared_lock<shared_mutex> lock(rw);
+        return inner->SummarizeByLab();
+    }
+};
+
+// ==========================================
+// SCHEDULING SERVICES
+// ==========================================
+
+/**
+ * @class ScheduleConflictIndex
+ * @brief Per-room, per-teacher and per-TA interval index used to detect double bookings.
+ * * Each resource/day pair keeps two ordered structures keyed on start minute:
+ * - busy: the union of all booked intervals, kept disjoint by merging on insert.
+ * - bookings: the individual intervals with their owners, used for reporting.
+ * Because the union is disjoint, an overlap test only needs the predecessor of
+ * the new end time, so CheckSection is O(log n) per resource. The owner of a
+ * confirmed overlap is looked up from the latest start that can still reach
+ * the slot (start - longest booking), which keeps that step O(log n + k) for
+ * the k bookings it has to step over.
+ * * Weekly bookings live under their weekday key and dated ones under their
+ * date. A date is also checked against its weekday's timeline, and a weekly slot
+ * against the dated timelines inside its term; each booking's Recurrence then
+ * confirms that the two actually meet on a common date. Dated timelines are also
+ * indexed by (resource, weekday), so a weekly slot finds the m dates it could meet
+ * with one range lookup in O(log n + m) rather than walking every dated booking.
+ */
+class ScheduleConflictIndex : public ScheduleObserver
+{
+public:
+    enum ResourceKind
+    {
+        ROOM = 0,
+        TEACHER = 1,
+        TA = 2
+    };
+
+    struct Conflict
+    {
+        ResourceKind kind;
+        int resourceId;
+        int32_t day;
+        int start;
+        int end;
+        string first;
+        string second;
+    };
+
+private:
+    struct Booking
+    {
+        int end;
+        string owner;
+        Recurrence rule;
+    };
+
+    struct Timeline
+    {
+        map<int, int> busy;              // start -> end, disjoint union of all bookings
+        multimap<int, Booking> bookings; // start -> booking
+        int longest = 0;                 // longest booking, bounds how far back an overlap can start
+        int32_t firstDate = INT32_MAX;   // weekly timelines: the dates their bookings' terms can reach
+        int32_t lastDate = -1;
+
+        /**
+         * @brief First booking that can end after 'start'.
+         */
+        multimap<int, Booking>::const_iterator FirstReaching(int start) const
+        {
+            return bookings.lower_bound(start - longest + 1);
+        }
+    };
+
+    // (kind, resource id, packed day) -> timeline
+    map<tuple<int, int, int32_t>, Timeline> timelines;
+    // (kind, resource id, weekday) -> date -> that date's timeline
+    map<tuple<int, int, int>, map<int32_t, const Timeline *>> datesByWeekday;
+
+    static string OwnerLabel(int labId, const ClassSection &sec)
+    {
+        return "Lab " + to_string(labId) + " / Sec " + sec.GetSectionName();
+    }
+
+    /**
+     * @brief Collects the resources a section occupies.
+     */
+    static vector<pair<ResourceKind, int>> ResourcesOf(const ClassSection &sec)
+    {
+        vector<pair<ResourceKind, int>> res;
+        if (sec.GetRoom())
+            res.push_back({ROOM, sec.GetRoom()->GetId()});
+        if (sec.GetTeacher())
+            res.push_back({TEACHER, sec.GetTeacher()->GetId()});
+        for (auto *ta : sec.GetAssistants())
+            if (ta)
+                res.push_back({TA, ta->GetId()});
+        return res;
+    }
+
+    /**
+     * @brief Returns a booking accepted by 'keep' that overlaps [start, end) on a timeline, or nullptr.
+     */
+    template <typename Keep>
+    static const pair<const int, Booking> *FindOverlap(const Timeline &tl, int start, int end, Keep keep)
+    {
+        // Predecessor of 'end' in the disjoint union is the only span that can overlap
+        auto it = tl.busy.lower_bound(end);
+        if (it == tl.busy.begin())
+            return nullptr;
+        --it;
+        if (it->second <= start)
+            return nullptr;
+
+        // Overlap confirmed; locate an owner to report
+        for (auto b = tl.FirstReaching(start); b != tl.bookings.end() && b->first < end; ++b)
+            if (b->second.end > start && keep(b->second))
+                return &*b;
+        return nullptr;
+    }
+
+    /**
+     * @brief Visits (day, timeline) for every timeline of a resource that a slot on 'day' could meet.
+     * Stops early when 'visit' returns false.
+     */
+    template <typename Visit>
+    void ForEachRelatedTimeline(ResourceKind kind, int id, int32_t day, const Recurrence &rule, Visit visit) const
+    {
+        auto same = timelines.find(make_tuple(static_cast<int>(kind), id, day));
+        if (same != timelines.end() && !visit(day, same->second))
+            return;
+
+        if (day >= 0)
+        {
+            // A date also meets that weekday's recurring bookings
+            int32_t weekly = -(DateAndTime::WeekdayOf(day) + 1);
+            auto it = timelines.find(make_tuple(static_cast<int>(kind), id, weekly));
+            if (it != timelines.end())
+                visit(weekly, it->second);
+            return;
+        }
+        if (day == DateAndTime::NO_DAY)
+            return;
+
+        // A weekly slot meets the dated bookings on its weekday within its term
+        ForEachDateOnWeekday(kind, id, DateAndTime::WeekdayOf(day), rule.HasTerm() ? rule.GetTermFrom() : 0,
+                             rule.HasTerm() ? rule.GetTermTo() : INT32_MAX, visit);
+    }
+
+    /**
+     * @brief Visits (date, timeline) for a resource's dated timelines on one weekday in [from, to].
+     * Stops early when 'visit' returns false.
+     */
+    template <typename Visit>
+    void ForEachDateOnWeekday(ResourceKind kind, int id, int weekday, int32_t from, int32_t to, Visit visit) const
+    {
+        auto dates = datesByWeekday.find(make_tuple(static_cast<int>(kind), id, weekday));
+        if (dates == datesByWeekday.end())
+            return;
+        for (auto it = dates->second.lower_bound(from); it != dates->second.end() && it->first <= to; ++it)
+            if (!visit(it->first, *it->second))
+                return;
+    }
+
+    static void InsertBusy(map<int, int> &busy, int start, int end)
+    {
+        auto it = busy.upper_bound(start);
+        if (it != busy.begin())
+        {
+            auto before = std::prev(it);
+            if (before->second >= start)
+            {
+                start = before->first;
+                end = max(end, before->second);
+                it = busy.erase(before);
+            }
+        }
+        while (it != busy.end() && it->first <= end)
+        {
+            end = max(end, it->second);
+            it = busy.erase(it);
+        }
+        busy[start] = end;
+    }
+
+public:
+    static const char *KindName(ResourceKind k)
+    {
+        return k == ROOM ? "Room" : (k == TEACHER ? "Teacher" : "TA");
+    }
+
+    /**
+     * @brief Checks a candidate section against everything already committed.
+     * @return Conflicts found (empty if the section can be scheduled).
+     */
+    vector<Conflict> CheckSection(int labId, const ClassSection &sec) const
+    {
+        vector<Conflict> found;
+        const DateAndTime &t = sec.GetScheduleTime();
+        if (!t.HasTimes() || t.GetDurationMinutes() <= 0)
+            return found;
+
+        int start = t.GetStartMinute();
+        int end = t.GetEndMinute();
+        int32_t day = t.GetDay();
+        const Recurrence &rule = sec.GetRecurrence();
+        for (const auto &r : ResourcesOf(sec))
+        {
+            ForEachRelatedTimeline(r.first, r.second, day, rule, [&](int32_t otherDay, const Timeline &tl)
+            {
+                const pair<const int, Booking> *hit = FindOverlap(tl, start, end, [&](const Booking &b)
+                                                                  { return Recurrence::ShareDate(day, rule, otherDay, b.rule); });
+                if (!hit)
+                    return true;
+                found.push_back({r.first, r.second, day >= 0 ? day : otherDay, hit->first, hit->second.end,
+                                 hit->second.owner, OwnerLabel(labId, sec)});
+                return false;
+            });
+        }
+        return found;
+    }
+
+    void OnSectionAdded(const CourseLaboratory &lab, const ClassSection &sec) override
+    {
+        const DateAndTime &t = sec.GetScheduleTime();
+        if (!t.HasTimes() || t.GetDurationMinutes() <= 0)
+            return;
+
+        int start = t.GetStartMinute();
+        int end = t.GetEndMinute();
+        int32_t day = t.GetDay();
+        string owner = OwnerLabel(lab.GetLabId(), sec);
+        for (const auto &r : ResourcesOf(sec))
+        {
+            Timeline &tl = timelines[make_tuple(static_cast<int>(r.first), r.second, day)];
+            InsertBusy(tl.busy, start, end);
+            tl.bookings.insert({start, {end, owner, sec.GetRecurrence()}});
+            tl.longest = max(tl.longest, end - start);
+            if (day >= 0)
+                datesByWeekday[make_tuple(static_cast<int>(r.first), r.second, DateAndTime::WeekdayOf(day))].emplace(day, &tl);
+            else if (day != DateAndTime::NO_DAY)
+            {
+                const Recurrence &rule = sec.GetRecurrence();
+                tl.firstDate = min(tl.firstDate, rule.HasTerm() ? rule.GetTermFrom() : 0);
+                tl.lastDate = max(tl.lastDate, rule.HasTerm() ? rule.GetTermTo() : INT32_MAX);
+            }
+        }
+    }
+
+    /**
+     * @brief Reports every overlapping pair across the whole schedule.
+     * * Sweeps each timeline in start order while keeping the active bookings
+     * ordered by end time: O(n log n + k) for n bookings and k conflicts. Each
+     * weekly timeline is then matched against the dated timelines on its weekday
+     * that its bookings' terms can reach, found through the weekday index.
+     */
+    vector<Conflict> AuditAll() const
+    {
+        vector<Conflict> found;
+        for (const auto &entry : timelines)
+        {
+            ResourceKind kind = static_cast<ResourceKind>(get<0>(entry.first));
+            int id = get<1>(entry.first);
+            int32_t day = get<2>(entry.first);
+
+            multimap<int, const pair<const int, Booking> *> active; // end -> booking
+            for (const auto &b : entry.second.bookings)
+            {
+                active.erase(active.begin(), active.upper_bound(b.first));
+                for (const auto &a : active)
+                    if (Recurrence::ShareDate(day, a.second->second.rule, day, b.second.rule))
+                        found.push_back({kind, id, day, b.first, min(b.second.end, a.first),
+                                         a.second->second.owner, b.second.owner});
+                active.insert({b.second.end, &b});
+            }
+
+            if (day >= 0 || day == DateAndTime::NO_DAY)
+                continue;
+            const Timeline &recurring = entry.second;
+            ForEachDateOnWeekday(kind, id, DateAndTime::WeekdayOf(day), recurring.firstDate, recurring.lastDate,
+                                 [&](int32_t date, const Timeline &dated)
+            {
+                for (const auto &b : dated.bookings)
+                    for (auto w = recurring.FirstReaching(b.first); w != recurring.bookings.end() && w->first < b.second.end; ++w)
+                        if (w->second.end > b.first && w->second.rule.OccursOn(day, date))
+                            found.push_back({kind, id, date, max(b.first, w->first), min(b.second.end, w->second.end),
+                                             w->second.owner, b.second.owner});
+                return true;
+            });
+        }
+        return found;
+    }
+
+    static void PrintConflict(const Conflict &c)
+    {
+        cout << "  " << KindName(c.kind) << " " << c.resourceId << " on " << DateAndTime::FormatDay(c.day)
+             << " at " << DateAndTime::FormatMinutes(c.start) << "-" << DateAndTime::FormatMinutes(c.end)
+             << ": " << c.first << " <-> " << c.second << "\n";
+    }
+};
+
+/**
+ * @class SectionPlacementSolver
+ * @brief Greedy batch placer for weekly sections over bitset availability.
+ * * The day is cut into 15-minute slots and every room, teacher and TA gets one
+ * bitset per weekday marking occupied slots, seeded from the committed schedule.
+ * Requests are placed most-constrained first (fewest free teacher/TA start slots,
+ * then longest), and a candidate (room, day, slot) is feasible when
+ * (room | teacher | TAs) leaves the whole run free, found with a few shifted
+ * ANDs per room and day instead of per-slot tests.
+ * Rooms are scanned in parallel chunks; chunk results are reduced in order, so
+ * the outcome does not depend on the number of workers.
+ */
+class SectionPlacementSolver
+{
+public:
+    static const int SLOT_MINUTES = 15;
+    static const int SLOTS_PER_DAY = 24 * 60 / SLOT_MINUTES;
+    static const int FIRST_SLOT = 8 * 60 / SLOT_MINUTES; // 08:00
+    static const int LAST_SLOT = 20 * 60 / SLOT_MINUTES; // 20:00, exclusive
+    static const int WORK_DAYS = 5;                      // Monday .. Friday
+    static const size_t MIN_ROOMS_PER_WORKER = 64;
+
+    typedef bitset<SLOTS_PER_DAY> DayMask;
+    typedef array<DayMask, 7> WeekMask;
+
+    struct Request
+    {
+        int labId;
+        string courseCode;
+        string sectionName;
+        int teacherId;
+        vector<int> taIds;
+        int durationMinutes;
+    };
+
+    struct Placement
+    {
+        size_t request; // index into the request list
+        int roomId;
+        int weekday; // 0 = Monday
+        int startMinute;
+        int endMinute;
+    };
+
+    struct Result
+    {
+        vector<Placement> placed;
+        vector<pair<size_t, string>> unplaced; // request index, reason
+        double solveMillis;
+    };
+
+private:
+    struct Candidate
+    {
+        long score; // lower is better
+        size_t room;
+        int day;
+        int slot;
+    };
+
+    vector<int> roomIds; // dense room index -> room ID
+    vector<WeekMask> roomBusy;
+    unordered_map<int, size_t> roomSlotById;
+    unordered_map<int, WeekMask> teacherBusy;
+    unordered_map<int, WeekMask> taBusy;
+    unsigned workers;
+
+    /**
+     * @brief Marks a slot as busy on its weekday.
+     * * Dated sections block their weekday as well: a weekly placement recurs
+     * every week, so it must not collide with any one-off booking either.
+     */
+    static void Occupy(WeekMask &w, const DateAndTime &t)
+    {
+        int wd = t.GetWeekday();
+        if (wd < 0 || !t.HasTimes() || t.GetDurationMinutes() <= 0)
+            return;
+        w[wd] |= SpanMask(t.GetStartMinute(), t.GetEndMinute());
+    }
+
+    WeekMask PeopleBusy(const Request &r) const
+    {
+        WeekMask busy;
+        auto t = teacherBusy.find(r.teacherId);
+        if (t != teacherBusy.end())
+            busy = t->second;
+        for (int id : r.taIds)
+        {
+            auto ta = taBusy.find(id);
+            if (ta != taBusy.end())
+                for (int d = 0; d < 7; d++)
+                    busy[d] |= ta->second[d];
+        }
+        return busy;
+    }
+
+    static int FreeStarts(const WeekMask &busy, const DayMask &run, int slots)
+    {
+        int free = 0;
+        for (int d = 0; d < WORK_DAYS; d++)
+            for (int s = FIRST_SLOT; s + slots <= LAST_SLOT; s++)
+                free += (busy[d] & (run << s)).none();
+        return free;
+    }
+
+    /**
+     * @brief Best candidate among rooms [lo, hi).
+     * * Prefers slots that touch an existing booking or the edge of the day, which
+     * keeps rooms densely packed, then the earliest day and time.
+     */
+    void ScanRooms(size_t lo, size_t hi, const WeekMask &people, int slots, Candidate &best) const
+    {
+        for (size_t r = lo; r < hi; r++)
+        {
+            for (int d = 0; d < WORK_DAYS; d++)
+            {
+                const DayMask &room = roomBusy[r][d];
+                // fits[s] is set when slots s .. s+slots-1 are all free
+                DayMask free = ~(room | people[d]);
+                DayMask fits = free;
+                for (int k = 1; k < slots && fits.any(); k++)
+                    fits &= free >> k;
+                for (int s = FIRST_SLOT; s + slots <= LAST_SLOT; s++)
+                {
+                    if (!fits[s])
+                        continue;
+                    int adjacent = (s == FIRST_SLOT || room[s - 1]) + (s + slots == LAST_SLOT || room[s + slots]);
+                    long score = (2 - adjacent) * 10000L + d * SLOTS_PER_DAY + s;
+                    if (score < best.score)
+                        best = {score, r, d, s};
+                }
+            }
+        }
+    }
+
+    Candidate FindBest(const WeekMask &people, int slots) const
+    {
+        Candidate best = {LONG_MAX, 0, -1, -1};
+        size_t n = roomIds.size();
+        size_t chunks = ParallelFor::ChunkCount(n, MIN_ROOMS_PER_WORKER, workers);
+        vector<Candidate> partial(chunks, best);
+        ParallelFor::Run(n, chunks, [&](size_t c, size_t lo, size_t hi)
+                         { ScanRooms(lo, hi, people, slots, partial[c]); });
+        for (const auto &p : partial)
+            if (p.score < best.score)
+                best = p;
+        return best;
+    }
+
+public:
+    SectionPlacementSolver(LabDetails *lDetails, VenueDetails *vDetails, unsigned workerCount = thread::hardware_concurrency())
+        : workers(max(1u, workerCount))
+    {
+        for (const auto &room : vDetails->GetAllRooms())
+        {
+            roomSlotById.emplace(room.GetId(), roomIds.size());
+            roomIds.push_back(room.GetId());
+        }
+        roomBusy.resize(roomIds.size());
+
+        for (const auto &lab : lDetails->GetAllLabs())
+        {
+            for (const auto &sec : lab.GetSections())
+            {
+                const DateAndTime &t = sec.GetScheduleTime();
+                if (sec.GetRoom())
+                {
+                    auto it = roomSlotById.find(sec.GetRoom()->GetId());
+                    if (it != roomSlotById.end())
+                        Occupy(roomBusy[it->second], t);
+                }
+                if (sec.GetTeacher())
+                    Occupy(teacherBusy[sec.GetTeacher()->GetId()], t);
+                for (auto *ta : sec.GetAssistants())
+                    if (ta)
+                        Occupy(taBusy[ta->GetId()], t);
+            }
+        }
+    }
+
+    unsigned GetWorkerCount() const { return workers; }
+
+    /**
+     * @brief Slots touched by [startMinute, endMinute), rounded outwards.
+     */
+    static DayMask SpanMask(int startMinute, int endMinute)
+    {
+        DayMask m;
+        int last = min((endMinute + SLOT_MINUTES - 1) / SLOT_MINUTES, static_cast<int>(SLOTS_PER_DAY));
+        for (int s = startMinute / SLOT_MINUTES; s < last; s++)
+            m.set(s);
+        return m;
+    }
+
+    /**
+     * @brief Reads "labId,courseCode,section,teacherId,minutes[,taId;taId...]" lines.
+     * * Blank lines, '#' comments and a non-numeric header row are skipped.
+     * @param badLines Receives the line numbers that could not be parsed.
+     * @return false if the file cannot be opened.
+     */
+    static bool ReadRequests(const string &path, vector<Request> &out, vector<int> &badLines)
+    {
+        ifstream in(path);
+        if (!in)
+            return false;
+
+        string line;
+        bool headerAllowed = true;
+        for (int lineNo = 1; getline(in, line); lineNo++)
+        {
+            if (!line.empty() && line.back() == '\r')
+                line.pop_back();
+            if (line.empty() || line[0] == '#')
+                continue;
+
+            vector<string> fields;
+            size_t pos = 0;
+            while (true)
+            {
+                size_t comma = line.find(',', pos);
+                fields.push_back(line.substr(pos, comma == string::npos ? string::npos : comma - pos));
+                if (comma == string::npos)
+                    break;
+                pos = comma + 1;
+            }
+
+            Request r;
+            char *end = nullptr;
+            r.labId = fields.size() >= 5 ? static_cast<int>(strtol(fields[0].c_str(), &end, 10)) : 0;
+            if (fields.size() < 5 || end == fields[0].c_str())
+            {
+                if (!headerAllowed || fields.size() < 5)
+                    badLines.push_back(lineNo);
+                headerAllowed = false;
+                continue;
+            }
+            headerAllowed = false;
+            r.courseCode = fields[1];
+            r.sectionName = fields[2];
+            r.teacherId = atoi(fields[3].c_str());
+            r.durationMinutes = atoi(fields[4].c_str());
+            if (fields.size() > 5)
+            {
+                const char *p = fields[5].c_str();
+                while (*p)
+                {
+                    long id = strtol(p, &end, 10);
+                    if (end == p)
+                    {
+                        p++; // separator
+                        continue;
+                    }
+                    r.taIds.push_back(static_cast<int>(id));
+                    p = end;
+                }
+            }
+            if (!DataValidator::IsValidID(r.labId) || !DataValidator::IsNonEmptyString(r.courseCode) ||
+                !DataValidator::IsNonEmptyString(r.sectionName))
+            {
+                badLines.push_back(lineNo);
+                continue;
+            }
+            out.push_back(r);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Places as many requests as possible without touching the lab store.
+     * * The solver's own masks are updated as it goes, so the placements are
+     * conflict-free among themselves and against the seeded schedule.
+     * @param admit Called before each placement is taken; a non-empty reason leaves
+     * the request unplaced. For limits the masks do not model, such as weekly workload.
+     */
+    Result Solve(const vector<Request> &requests, FacultyDetails *fDetails,
+                 const function<string(const Request &)> &admit = nullptr)
+    {
+        auto started = chrono::steady_clock::now();
+        Result result;
+
+        struct Pending
+        {
+            size_t index;
+            int freeStarts;
+            int slots;
+        };
+        vector<Pending> order;
+        for (size_t i = 0; i < requests.size(); i++)
+        {
+            const Request &r = requests[i];
+            int slots = (r.durationMinutes + SLOT_MINUTES - 1) / SLOT_MINUTES;
+            string reason;
+            if (!fDetails->FindTeacher(r.teacherId))
+                reason = "teacher " + to_string(r.teacherId) + " not found";
+            for (int id : r.taIds)
+                if (reason.empty() && !fDetails->FindTA(id))
+                    reason = "TA " + to_string(id) + " not found";
+            if (reason.empty() && (r.durationMinutes <= 0 || slots > LAST_SLOT - FIRST_SLOT))
+                reason = "invalid duration";
+            if (!reason.empty())
+            {
+                result.unplaced.push_back({i, reason});
+                continue;
+            }
+
+            DayMask run;
+            for (int k = 0; k < slots; k++)
+                run.set(k);
+            order.push_back({i, FreeStarts(PeopleBusy(r), run, slots), slots});
+        }
+
+        stable_sort(order.begin(), order.end(), [](const Pending &a, const Pending &b)
+                    { return a.freeStarts != b.freeStarts ? a.freeStarts < b.freeStarts : a.slots > b.slots; });
+
+        for (const auto &p : order)
+        {
+            const Request &r = requests[p.index];
+            DayMask run;
+            for (int k = 0; k < p.slots; k++)
+                run.set(k);
+
+            Candidate c = FindBest(PeopleBusy(r), p.slots);
+            if (c.day < 0)
+            {
+                result.unplaced.push_back({p.index, "no free room and time for teacher and TAs"});
+                continue;
+            }
+            string refused = admit ? admit(r) : "";
+            if (!refused.empty())
+            {
+                result.unplaced.push_back({p.index, refused});
+                continue;
+            }
+
+            DayMask taken = run << c.slot;
+            roomBusy[c.room][c.day] |= taken;
+            teacherBusy[r.teacherId][c.day] |= taken;
+            for (int id : r.taIds)
+                taBusy[id][c.day] |= taken;
+
+            int start = c.slot * SLOT_MINUTES;
+            result.placed.push_back({p.index, roomIds[c.room], c.day, start, start + r.durationMinutes});
+        }
+
+        result.solveMillis = chrono::duration<double, milli>(chrono::steady_clock::now() - started).count();
+        return result;
+    }
+};
+
+/**
+ * @class MakeupSlotAdvisor
+ * @brief Suggests the free (room, time) slots closest to a makeup request.
+ * * Keeps a 15-minute busy bitmap per resource per day (rooms, teachers, TAs and
+ * the section itself), maintained incrementally from OnSectionAdded. Weekly
+ * bookings live under their weekday key and dated ones under their date, so the
+ * busy map for a date is the OR of the two. A query scans the requested day and
+ * the three days either side, and keeps the k nearest candidates in a bounded heap.
+ */
+class MakeupSlotAdvisor : public ScheduleObserver
+{
+public:
+    static const int SEARCH_DAYS = 3;
+
+    struct Suggestion
+    {
+        int roomId;
+        int32_t day;
+        int start;
+        int end;
+        int distance; // minutes away from the requested start, a day counting as 1440
+    };
+
+private:
+    typedef SectionPlacementSolver::DayMask DayMask;
+
+    enum ResourceKind
+    {
+        ROOM = 0,
+        TEACHER = 1,
+        TA = 2,
+        SECTION = 3,
+        KIND_COUNT = 4
+    };
+
+    unordered_map<uint64_t, DayMask> busy[KIND_COUNT]; // per kind: (id, day) -> occupied slots
+    unordered_map<uint64_t, int> sectionKeys; // (lab id, base section symbol) -> dense id
+
+    static uint64_t Key(int id, int32_t day)
+    {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(id)) << 32) | static_cast<uint32_t>(day);
+    }
+
+    /**
+     * @brief Dense ID for the section a booking belongs to; "X_MAKEUP" counts as "X".
+     */
+    int SectionKey(int labId, const string &sectionName)
+    {
+        static const string suffix = "_MAKEUP";
+        string base = sectionName;
+        if (base.size() > suffix.size() && base.compare(base.size() - suffix.size(), suffix.size(), suffix) == 0)
+            base.resize(base.size() - suffix.size());
+        uint64_t k = (static_cast<uint64_t>(static_cast<uint32_t>(labId)) << 32) | SymbolTable::Instance().Intern(base);
+        return sectionKeys.emplace(k, static_cast<int>(sectionKeys.size())).first->second;
+    }
+
+    DayMask BusyOn(ResourceKind kind, int id, int32_t day) const
+    {
+        DayMask m;
+        const unordered_map<uint64_t, DayMask> &table = busy[kind];
+        auto it = table.find(Key(id, day));
+        if (it != table.end())
+            m = it->second;
+        if (day >= 0)
+        {
+            // A dated day also carries that weekday's recurring bookings
+            DateAndTime t;
+            t.SetPacked(day, 0, 0);
+            auto weekly = table.find(Key(id, -(t.GetWeekday() + 1)));
+            if (weekly != table.end())
+                m |= weekly->second;
+        }
+        return m;
+    }
+
+    static bool Before(const Suggestion &a, const Suggestion &b)
+    {
+        return tie(a.distance, a.day, a.start, a.roomId) < tie(b.distance, b.day, b.start, b.roomId);
+    }
+
+    static void Offer(vector<Suggestion> &heap, size_t k, const Suggestion &s)
+    {
+        if (heap.size() == k)
+        {
+            if (!Before(s, heap.front()))
+                return;
+            pop_heap(heap.begin(), heap.end(), Before);
+            heap.pop_back();
+        }
+        heap.push_back(s);
+        push_heap(heap.begin(), heap.end(), Before);
+    }
+
+public:
+    void OnSectionAdded(const CourseLaboratory &lab, const ClassSection &sec) override
+    {
+        const DateAndTime &t = sec.GetScheduleTime();
+        if (t.GetDay() == DateAndTime::NO_DAY || !t.HasTimes() || t.GetDurationMinutes() <= 0)
+            return;
+
+        DayMask span = SectionPlacementSolver::SpanMask(t.GetStartMinute(), t.GetEndMinute());
+        int32_t day = t.GetDay();
+        if (sec.GetRoom())
+            busy[ROOM][Key(sec.GetRoom()->GetId(), day)] |= span;
+        if (sec.GetTeacher())
+            busy[TEACHER][Key(sec.GetTeacher()->GetId(), day)] |= span;
+        for (auto *ta : sec.GetAssistants())
+            if (ta)
+                busy[TA][Key(ta->GetId(), day)] |= span;
+        busy[SECTION][Key(SectionKey(lab.GetLabId(), sec.GetSectionName()), day)] |= span;
+    }
+
+    /**
+     * @brief Top-k free slots for a makeup of 'base', nearest to 'wanted' first.
+     * * The requested time itself is tried exactly; other candidates start on the
+     * 15-minute grid within the solver's teaching window.
+     */
+    vector<Suggestion> Suggest(VenueDetails *vDetails, int labId, const ClassSection &base, const DateAndTime &wanted, size_t k)
+    {
+        vector<Suggestion> heap;
+        int duration = wanted.GetDurationMinutes();
+        if (k == 0 || wanted.GetDay() == DateAndTime::NO_DAY || duration <= 0)
+            return heap;
+
+        const int slotMinutes = SectionPlacementSolver::SLOT_MINUTES;
+        int slots = (duration + slotMinutes - 1) / slotMinutes;
+        int wantedStart = wanted.GetStartMinute();
+        int sectionId = SectionKey(labId, base.GetSectionName());
+        deque<LectureHall> &rooms = vDetails->GetAllRooms();
+
+        for (int offset = -SEARCH_DAYS; offset <= SEARCH_DAYS; offset++)
+        {
+            int32_t day = wanted.GetDay() + offset;
+            if (wanted.IsWeekly())
+                day = -((wanted.GetWeekday() + offset + 7) % 7 + 1);
+
+            DayMask people = BusyOn(SECTION, sectionId, day);
+            if (base.GetTeacher())
+                people |= BusyOn(TEACHER, base.GetTeacher()->GetId(), day);
+            for (auto *ta : base.GetAssistants())
+                if (ta)
+                    people |= BusyOn(TA, ta->GetId(), day);
+
+            for (const auto &room : rooms)
+            {
+                DayMask taken = BusyOn(ROOM, room.GetId(), day) | people;
+                if (offset == 0 && (taken & SectionPlacementSolver::SpanMask(wantedStart, wantedStart + duration)).none())
+                    Offer(heap, k, {room.GetId(), day, wantedStart, wantedStart + duration, 0});
+
+                DayMask free = ~taken;
+                DayMask fits = free;
+                for (int s = 1; s < slots && fits.any(); s++)
+                    fits &= free >> s;
+                for (int s = SectionPlacementSolver::FIRST_SLOT; s + slots <= SectionPlacementSolver::LAST_SLOT; s++)
+                {
+                    int start = s * slotMinutes;
+                    if (!fits[s] || (offset == 0 && start == wantedStart))
+                        continue;
+                    Offer(heap, k, {room.GetId(), day, start, start + duration, abs(offset) * 1440 + abs(start - wantedStart)});
+                }
+            }
+        }
+
+        sort_heap(heap.begin(), heap.end(), Before);
+        return heap;
+    }
+};
+
+/**
+ * @class WeeklyScheduleView
+ * @brief Materialised HOD weekly schedule, kept up to date from OnSectionAdded.
+ * * Sections are bucketed by day as they are committed, each stored as its
+ * rendered text and kept in (store slot of the lab, section) order, which is
+ * the order the store lists its labs in. The full report is rendered
+ * once into a buffer and reused until the next section arrives, so repeated
+ * views cost only the output.
+ */
+class WeeklyScheduleView : public ScheduleObserver
+{
+    struct Entry
+    {
+        size_t labSlot;
+        size_t sectionIndex;
+        string text;
+
+        bool operator<(const Entry &o) const { return tie(labSlot, sectionIndex) < tie(o.labSlot, o.sectionIndex); }
+    };
+
+    struct DayBucket
+    {
+        string heading;
+        vector<Entry> entries;
+    };
+
+    // Weekday slots first (Monday..Sunday), then undated, then dates ascending
+    map<pair<int, int32_t>, DayBucket> byDay;
+    unordered_map<int, size_t> labSlot; // lab ID -> position in the store, as reported by OnLabAdded
+    string rendered;
+    bool dirty = true;
+
+    static pair<int, int32_t> DayKey(const DateAndTime &t)
+    {
+        if (t.IsWeekly())
+            return {0, t.GetWeekday()};
+        if (t.GetDay() == DateAndTime::NO_DAY)
+            return {1, 0};
+        return {2, t.GetDay()};
+    }
+
+    static string RenderSection(const CourseLaboratory &lab, const ClassSection &sec)
+    {
+        const DateAndTime &t = sec.GetScheduleTime();
+        string out = "Lab ID: " + to_string(lab.GetLabId()) + " | Course: " + lab.GetCourseCode() + "\n";
+        out += "  Section: " + sec.GetSectionName() + "\n";
+        out += "  Time: " + t.GetStartTime() + " - " + t.GetEndTime() + "\n";
+        out += "  Venue: " + (sec.GetBuilding() ? sec.GetBuilding()->GetName() : string("N/A")) +
+               " - Room " + (sec.GetRoom() ? sec.GetRoom()->GetRoomNumber() : string("N/A")) + "\n";
+        out += "  Instructor: " + (sec.GetTeacher() ? sec.GetTeacher()->GetName() : string("Unassigned")) + "\n";
+        if (!sec.GetRecurrence().IsEmpty())
+            out += "  Meets: " + sec.GetDayText() + "\n";
+        return out;
+    }
+
+public:
+    void OnLabAdded(const CourseLaboratory &lab, size_t slot) override
+    {
+        // Like the store's index, the first lab with a given ID keeps its slot
+        labSlot.emplace(lab.GetLabId(), slot);
+    }
+
+    void OnSectionAdded(const CourseLaboratory &lab, const ClassSection &sec) override
+    {
+        Entry e;
+        e.labSlot = labSlot.emplace(lab.GetLabId(), labSlot.size()).first->second;
+        e.sectionIndex = static_cast<size_t>(&sec - lab.GetSections().data());
+        e.text = RenderSection(lab, sec);
+
+        // New sections almost always sort last, making this an append
+        DayBucket &bucket = byDay[DayKey(sec.GetScheduleTime())];
+        if (bucket.heading.empty())
+            bucket.heading = "\n--- " + sec.GetScheduleTime().GetDate() + " ---\n";
+        bucket.entries.insert(upper_bound(bucket.entries.begin(), bucket.entries.end(), e), std::move(e));
+        dirty = true;
+    }
+
+    /**
+     * @brief The day-grouped schedule text, rebuilt only if a section was added since the last call.
+     */
+    const string &Render()
+    {
+        if (!dirty)
+            return rendered;
+
+        rendered.clear();
+        for (const auto &day : byDay)
+        {
+            rendered += day.second.heading;
+            for (const auto &e : day.second.entries)
+                rendered += e.text;
+        }
+        dirty = false;
+        return rendered;
+    }
+};
+
+/**
+ * @class RoomUtilization
+ * @brief Occupancy of rooms and buildings by minute of the week.
+ * * Each room keeps a bitmap of the analysed week, one bit per minute from
+ * Monday 00:00, plus a running popcount per 64-bit word. The busy minutes in
+ * any [from, to) range are then two rank lookups. Bookings arrive through
+ * OnSectionAdded and only mark their room dirty; Refresh rebuilds the dirty
+ * rooms in parallel, so recomputing after a schedule change touches one room.
+ * * The week is either a calendar week, where terms, skipped dates and one-off
+ * dates apply, or the typical week: every weekly slot and no dated sessions.
+ */
+class RoomUtilization : public ScheduleObserver
+{
+public:
+    static const int DAY_MINUTES = 1440;
+    static const int WEEK_MINUTES = 7 * DAY_MINUTES;
+    static const int WINDOW_START = 8 * 60; // teaching window that percentages refer to
+    static const int WINDOW_END = 20 * 60;
+    static const int WINDOW_DAYS = 5;
+    static const size_t MIN_ROOMS_PER_WORKER = 64;
+
+    struct RoomStats
+    {
+        int roomId;
+        int buildingId;
+        int busyMinutes;   // inside the teaching window
+        int windowMinutes; // length of the teaching window
+    };
+
+private:
+    static const int WORDS = (WEEK_MINUTES + 63) / 64;
+
+    struct Booking
+    {
+        int32_t day;
+        int start;
+        int end;
+        Recurrence rule;
+    };
+
+    struct RoomState
+    {
+        vector<Booking> bookings;
+        array<uint64_t, WORDS> bits;
+        array<uint16_t, WORDS + 1> rank; // busy minutes before each word
+        bool dirty = false;              // queued in dirtyRooms
+    };
+
+    unordered_map<int, RoomState> rooms; // room ID -> state
+    vector<RoomState *> dirtyRooms;
+    int32_t weekStart = DateAndTime::NO_DAY; // Monday of the analysed week, or NO_DAY for the typical week
+
+    static void SetRange(array<uint64_t, WORDS> &bits, int from, int to)
+    {
+        for (int m = from; m < to;)
+        {
+            int bit = m & 63;
+            int len = min(64 - bit, to - m);
+            uint64_t mask = len == 64 ? ~0ull : ((1ull << len) - 1) << bit;
+            bits[m >> 6] |= mask;
+            m += len;
+        }
+    }
+
+    void Rebuild(RoomState &room) const
+    {
+        room.bits.fill(0);
+        for (const auto &b : room.bookings)
+        {
+            if (weekStart == DateAndTime::NO_DAY)
+            {
+                if (b.day < 0 && b.day != DateAndTime::NO_DAY)
+                    SetRange(room.bits, DateAndTime::WeekdayOf(b.day) * DAY_MINUTES + b.start,
+                             DateAndTime::WeekdayOf(b.day) * DAY_MINUTES + b.end);
+                continue;
+            }
+            b.rule.ForEachOccurrence(b.day, weekStart, weekStart + 6, [&](int32_t date)
+            {
+                int base = (date - weekStart) * DAY_MINUTES;
+                SetRange(room.bits, base + b.start, base + b.end);
+                return true;
+            });
+        }
+
+        room.rank[0] = 0;
+        for (int w = 0; w < WORDS; w++)
+            room.rank[w + 1] = static_cast<uint16_t>(room.rank[w] + bitset<64>(room.bits[w]).count());
+        room.dirty = false;
+    }
+
+    static int Rank(const RoomState &room, int minute)
+    {
+        int w = minute >> 6;
+        int bit = minute & 63;
+        if (bit == 0)
+            return room.rank[w];
+        return room.rank[w] + static_cast<int>(bitset<64>(room.bits[w] & ((1ull << bit) - 1)).count());
+    }
+
+    void MarkDirty(RoomState &room)
+    {
+        if (room.dirty)
+            return;
+        room.dirty = true;
+        dirtyRooms.push_back(&room);
+    }
+
+public:
+    void OnSectionAdded(const CourseLaboratory &, const ClassSection &sec) override
+    {
+        const DateAndTime &t = sec.GetScheduleTime();
+        if (!sec.GetRoom() || !t.HasTimes() || t.GetDurationMinutes() <= 0)
+            return;
+        RoomState &room = rooms[sec.GetRoom()->GetId()];
+        room.bookings.push_back({t.GetDay(), t.GetStartMinute(), t.GetEndMinute(), sec.GetRecurrence()});
+        MarkDirty(room);
+    }
+
+    /**
+     * @brief Selects the analysed week by its Monday, or NO_DAY for the typical week.
+     */
+    void SetWeek(int32_t monday)
+    {
+        if (monday == weekStart)
+            return;
+        weekStart = monday;
+        for (auto &entry : rooms)
+            MarkDirty(entry.second);
+    }
+    int32_t GetWeek() const { return weekStart; }
+
+    /**
+     * @brief Rebuilds the rooms changed since the last call.
+     * @return Number of rooms rebuilt.
+     */
+    size_t Refresh()
+    {
+        size_t n = dirtyRooms.size();
+        if (n == 0)
+            return 0;
+        ParallelFor::Run(n, ParallelFor::ChunkCount(n, MIN_ROOMS_PER_WORKER), [this](size_t, size_t lo, size_t hi)
+                         {
+                             for (size_t i = lo; i < hi; i++)
+                                 Rebuild(*dirtyRooms[i]);
+                         });
+        dirtyRooms.clear();
+        return n;
+    }
+
+    /**
+     * @brief Busy minutes of a room in [from, to), minutes counted from Monday 00:00.
+     */
+    int BusyMinutes(int roomId, int from, int to) const
+    {
+        auto it = rooms.find(roomId);
+        if (it == rooms.end() || from >= to)
+            return 0;
+        return Rank(it->second, to) - Rank(it->second, from);
+    }
+
+    /**
+     * @brief Teaching-window occupancy for every room in the venue store.
+     */
+    vector<RoomStats> RoomTable(VenueDetails *vDetails) const
+    {
+        vector<RoomStats> out;
+        for (const auto &r : vDetails->GetAllRooms())
+        {
+            int busy = 0;
+            for (int d = 0; d < WINDOW_DAYS; d++)
+                busy += BusyMinutes(r.GetId(), d * DAY_MINUTES + WINDOW_START, d * DAY_MINUTES + WINDOW_END);
+            out.push_back({r.GetId(), r.GetBuildingId(), busy, WINDOW_DAYS * (WINDOW_END - WINDOW_START)});
+        }
+        return out;
+    }
+
+    /**
+     * @brief Busy room-minutes per (weekday, hour) summed over 'roomIds'.
+     */
+    array<array<int, 24>, 7> HourlyBusy(const vector<int> &roomIds) const
+    {
+        array<array<int, 24>, 7> grid = {};
+        for (int id : roomIds)
+            for (int d = 0; d < 7; d++)
+                for (int h = 0; h < 24; h++)
+                    grid[d][h] += BusyMinutes(id, d * DAY_MINUTES + h * 60, d * DAY_MINUTES + h * 60 + 60);
+        return grid;
+    }
+
+    /**
+     * @brief Writes "scope,weekday,hour,busy_minutes,capacity_minutes,percent" rows for
+     * every building and for the whole campus ("All"), ready to pivot into a heatmap.
+     * @return false if the file cannot be written.
+     */
+    bool ExportHeatmap(const string &path, VenueDetails *vDetails) const
+    {
+        ofstream out(path);
+        if (!out)
+            return false;
+
+        map<int, vector<int>> roomsByBuilding;
+        vector<int> all;
+        for (const auto &r : vDetails->GetAllRooms())
+        {
+            roomsByBuilding[r.GetBuildingId()].push_back(r.GetId());
+            all.push_back(r.GetId());
+        }
+
+        auto write = [&](const string &scope, const vector<int> &ids)
+        {
+            array<array<int, 24>, 7> grid = HourlyBusy(ids);
+            int capacity = static_cast<int>(ids.size()) * 60;
+            for (int d = 0; d < 7; d++)
+                for (int h = 0; h < 24; h++)
+                    out << scope << "," << DateAndTime::FormatDay(-(d + 1)) << "," << h << "," << grid[d][h] << ","
+                        << capacity << "," << fixed << setprecision(1) << (capacity ? 100.0 * grid[d][h] / capacity : 0.0) << "\n";
+        };
+        for (const auto &b : roomsByBuilding)
+        {
+            CampusBlock *block = vDetails->FindBuilding(b.first);
+            write(block ? block->GetName() : "Building " + to_string(b.first), b.second);
+        }
+        write("All", all);
+        return static_cast<bool>(out);
+    }
+};
+
+/**
+ * @class HoursReconciliation
+ * @brief Planned-vs-actual hours from the time sheets, per lab, teacher and week.
+ * * Sections are indexed once by (lab ID, section symbol). The rows that can
+ * hold dates in the range are then split into row ranges that are joined
+ * against the index in parallel, each
+ * worker accumulating into its own tables, which are merged at the end. A log
+ * plans its section's duration; a leave contributes no actual minutes. Starts
+ * after the planned start, or finishes before the planned end, by more than
+ * GRACE_MINUTES count as late or early.
+ */
+class HoursReconciliation
+{
+public:
+    static const int GRACE_MINUTES = 5;
+    static const size_t MIN_LOGS_PER_WORKER = 65536;
+
+    struct Totals
+    {
+        size_t sessions = 0;
+        size_t leaves = 0;
+        long plannedMinutes = 0;
+        long actualMinutes = 0;
+        size_t lateStarts = 0;
+        size_t earlyFinishes = 0;
+        long lateMinutes = 0;
+        long earlyMinutes = 0;
+
+        void Merge(const Totals &o)
+        {
+            sessions += o.sessions;
+            leaves += o.leaves;
+            plannedMinutes += o.plannedMinutes;
+            actualMinutes += o.actualMinutes;
+            lateStarts += o.lateStarts;
+            earlyFinishes += o.earlyFinishes;
+            lateMinutes += o.lateMinutes;
+            earlyMinutes += o.earlyMinutes;
+        }
+    };
+
+    struct Report
+    {
+        map<int, Totals> byLab;
+        map<int, Totals> byTeacher; // 0 = unassigned
+        map<int32_t, Totals> byWeek; // keyed by the week's Monday; NO_DAY for undated logs
+        Totals total;
+        size_t unmatched = 0; // logs whose section is not scheduled
+        double millis = 0;
+    };
+
+private:
+    struct Plan
+    {
+        int teacherId;
+        int start;
+        int end;
+    };
+
+    static uint64_t Key(int labId, SymbolId sectionId)
+    {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(labId)) << 32) | sectionId;
+    }
+
+    static void Accumulate(Totals &t, const Plan &plan, const WorkLog &log)
+    {
+        t.sessions++;
+        t.plannedMinutes += plan.end - plan.start;
+        if (log.GetIsLeave())
+        {
+            t.leaves++;
+            return;
+        }
+        const DateAndTime &actual = log.GetActualTiming();
+        if (!actual.HasTimes())
+            return;
+        t.actualMinutes += actual.GetDurationMinutes();
+        int late = actual.GetStartMinute() - plan.start;
+        int early = plan.end - actual.GetEndMinute();
+        if (late > GRACE_MINUTES)
+        {
+            t.lateStarts++;
+            t.lateMinutes += late;
+        }
+        if (early > GRACE_MINUTES)
+        {
+            t.earlyFinishes++;
+            t.earlyMinutes += early;
+        }
+    }
+
+    static void JoinRange(WorkLogDetails *logDetails, const unordered_map<uint64_t, Plan> &plans,
+                          int32_t fromDay, int32_t toDay, size_t lo, size_t hi, Report &out)
+    {
+        logDetails->ForEachEntryInRows(lo, hi, [&](const WorkLog &log)
+        {
+            int32_t day = log.GetActualTiming().GetDay();
+            if (day < fromDay || day > toDay)
+                return;
+            auto it = plans.find(Key(log.GetLabId(), log.GetSectionId()));
+            if (it == plans.end())
+            {
+                out.unmatched++;
+                return;
+            }
+            Accumulate(out.byLab[log.GetLabId()], it->second, log);
+            Accumulate(out.byTeacher[it->second.teacherId], it->second, log);
+            Accumulate(out.byWeek[day >= 0 ? day - DateAndTime::WeekdayOf(day) : DateAndTime::NO_DAY], it->second, log);
+        });
+    }
+
+public:
+    /**
+     * @brief Reconciles every log dated within [fromDay, toDay].
+     */
+    static Report Run(LabDetails *lDetails, WorkLogDetails *logDetails, int32_t fromDay, int32_t toDay)
+    {
+        auto started = chrono::steady_clock::now();
+        unordered_map<uint64_t, Plan> plans;
+        for (const auto &lab : lDetails->GetAllLabs())
+            for (const auto &sec : lab.GetSections())
+            {
+                const DateAndTime &t = sec.GetScheduleTime();
+                if (t.HasTimes())
+                    plans.emplace(Key(lab.GetLabId(), sec.GetSectionId()),
+                                  Plan{sec.GetTeacher() ? sec.GetTeacher()->GetId() : 0, t.GetStartMinute(), t.GetEndMinute()});
+            }
+
+        pair<size_t, size_t> span = logDetails->RowSpanForDays(fromDay, toDay);
+        size_t n = span.second - span.first;
+        vector<Report> partial(ParallelFor::ChunkCount(n, MIN_LOGS_PER_WORKER));
+        ParallelFor::Run(n, partial.size(), [&](size_t c, size_t lo, size_t hi)
+                         { JoinRange(logDetails, plans, fromDay, toDay, span.first + lo, span.first + hi, partial[c]); });
+
+        Report report;
+        for (const auto &p : partial)
+        {
+            for (const auto &e : p.byLab)
+                report.byLab[e.first].Merge(e.second);
+            for (const auto &e : p.byTeacher)
+                report.byTeacher[e.first].Merge(e.second);
+            for (const auto &e : p.byWeek)
+            {
+                report.byWeek[e.first].Merge(e.second);
+                report.total.Merge(e.second);
+            }
+            report.unmatched += p.unmatched;
+        }
+        report.millis = chrono::duration<double, milli>(chrono::steady_clock::now() - started).count();
+        return report;
+    }
+};
+
+/**
+ * @class FacultyWorkload
+ * @brief Reverse index from teachers and TAs to their sections, with contact-minute totals.
+ * * Maintained from OnSectionAdded. Each person keeps the minutes of their
+ * unbounded weekly slots, which count in every week, plus per-week adjustments
+ * for dated sessions, term-bounded slots (expanded once when added) and
+ * skipped dates. A week's load is therefore one addition and one hash lookup.
+ */
+class FacultyWorkload : public ScheduleObserver
+{
+public:
+    enum Role
+    {
+        TEACHER = 0,
+        TA = 1
+    };
+
+    static const int TEACHER_LIMIT_MINUTES = 18 * 60;
+    static const int TA_LIMIT_MINUTES = 20 * 60;
+
+    struct Assignment
+    {
+        int labId;
+        SymbolId sectionId;
+    };
+
+    struct Overload
+    {
+        Role role;
+        int id;
+        int32_t week; // Monday of the week, or NO_DAY for every week
+        int minutes;  // projected load in that week
+    };
+
+private:
+    struct Load
+    {
+        vector<Assignment> sections;
+        int recurringMinutes = 0;
+        unordered_map<int32_t, int> weekMinutes; // Monday -> adjustment on top of recurringMinutes
+    };
+
+    unordered_map<int, Load> loads[2];
+
+    static int32_t WeekOf(int32_t day) { return day - DateAndTime::WeekdayOf(day); }
+
+    /**
+     * @brief Visits the (week, minutes) changes a section makes to a person's load.
+     * A week of NO_DAY means every week.
+     */
+    template <typename Visit>
+    static void ForEachWeekDelta(const ClassSection &sec, Visit visit)
+    {
+        const DateAndTime &t = sec.GetScheduleTime();
+        int minutes = t.GetDurationMinutes();
+        int32_t day = t.GetDay();
+        const Recurrence &rule = sec.GetRecurrence();
+        if (minutes <= 0 || day == DateAndTime::NO_DAY)
+            return;
+        if (day >= 0)
+        {
+            visit(WeekOf(day), minutes);
+            return;
+        }
+        if (rule.HasTerm())
+        {
+            rule.ForEachOccurrence(day, rule.GetTermFrom(), rule.GetTermTo(), [&](int32_t date)
+            {
+                visit(WeekOf(date), minutes);
+                return true;
+            });
+            return;
+        }
+        visit(DateAndTime::NO_DAY, minutes);
+        for (int32_t skipped : rule.GetExceptions())
+            visit(WeekOf(skipped), -minutes);
+    }
+
+    void Apply(Role role, int id, int labId, const ClassSection &sec)
+    {
+        Load &load = loads[role][id];
+        load.sections.push_back({labId, sec.GetSectionId()});
+        ForEachWeekDelta(sec, [&](int32_t week, int minutes)
+        {
+            if (week == DateAndTime::NO_DAY)
+                load.recurringMinutes += minutes;
+            else
+                load.weekMinutes[week] += minutes;
+        });
+    }
+
+    /**
+     * @brief Heaviest week for one person if 'sec' were added on top of this index
+     * and 'planned' (if any), or false if it stays within the limit.
+     */
+    bool Projected(Role role, int id, const ClassSection &sec, const FacultyWorkload *planned, Overload &worst) const
+    {
+        worst = {role, id, DateAndTime::NO_DAY, 0};
+        auto loadIn = [&](int32_t week)
+        { return WeeklyMinutes(role, id, week) + (planned ? planned->WeeklyMinutes(role, id, week) : 0); };
+        ForEachWeekDelta(sec, [&](int32_t week, int minutes)
+        {
+            if (minutes < 0)
+                return;
+            if (week != DateAndTime::NO_DAY)
+            {
+                int load = loadIn(week) + minutes;
+                if (load > worst.minutes)
+                    worst = {role, id, week, load};
+                return;
+            }
+            // A recurring slot lands on top of every week, including the busiest dated ones
+            int base = loadIn(DateAndTime::NO_DAY);
+            if (base + minutes > worst.minutes)
+                worst = {role, id, DateAndTime::NO_DAY, base + minutes};
+            for (const FacultyWorkload *index : {this, planned})
+            {
+                if (!index)
+                    continue;
+                auto it = index->loads[role].find(id);
+                if (it != index->loads[role].end())
+                    for (const auto &w : it->second.weekMinutes)
+                        if (loadIn(w.first) + minutes > worst.minutes)
+                            worst = {role, id, w.first, loadIn(w.first) + minutes};
+            }
+        });
+        return worst.minutes > LimitMinutes(role);
+    }
+
+public:
+    static int LimitMinutes(Role role) { return role == TEACHER ? TEACHER_LIMIT_MINUTES : TA_LIMIT_MINUTES; }
+    static const char *RoleName(Role role) { return role == TEACHER ? "Teacher" : "TA"; }
+
+    void OnSectionAdded(const CourseLaboratory &lab, const ClassSection &sec) override
+    {
+        if (sec.GetTeacher())
+            Apply(TEACHER, sec.GetTeacher()->GetId(), lab.GetLabId(), sec);
+        for (auto *ta : sec.GetAssistants())
+            if (ta)
+                Apply(TA, ta->GetId(), lab.GetLabId(), sec);
+    }
+
+    /**
+     * @brief Contact minutes in the week starting 'monday', or in a typical week for NO_DAY.
+     */
+    int WeeklyMinutes(Role role, int id, int32_t monday) const
+    {
+        auto it = loads[role].find(id);
+        if (it == loads[role].end())
+            return 0;
+        int minutes = it->second.recurringMinutes;
+        if (monday != DateAndTime::NO_DAY)
+        {
+            auto week = it->second.weekMinutes.find(monday);
+            if (week != it->second.weekMinutes.end())
+                minutes += week->second;
+        }
+        return minutes;
+    }
+
+    const vector<Assignment> &SectionsOf(Role role, int id) const
+    {
+        static const vector<Assignment> none;
+        auto it = loads[role].find(id);
+        return it == loads[role].end() ? none : it->second.sections;
+    }
+
+    /**
+     * @brief The teacher and TAs that 'sec' would push over their weekly limit.
+     * @param planned Sections accepted but not yet in the store (e.g. earlier rows
+     * of a batch), fed to a separate FacultyWorkload through OnSectionAdded.
+     */
+    vector<Overload> CheckSection(const ClassSection &sec, const FacultyWorkload *planned = nullptr) const
+    {
+        vector<Overload> found;
+        Overload worst;
+        if (sec.GetTeacher() && Projected(TEACHER, sec.GetTeacher()->GetId(), sec, planned, worst))
+            found.push_back(worst);
+        for (auto *ta : sec.GetAssistants())
+            if (ta && Projected(TA, ta->GetId(), sec, planned, worst))
+                found.push_back(worst);
+        return found;
+    }
+
+    /**
+     * @brief "Teacher 4 will have 19.5 contact hours every week (limit 18)".
+     */
+    static string Describe(const Overload &o)
+    {
+        char hours[16];
+        snprintf(hours, sizeof(hours), "%g", o.minutes / 60.0);
+        return string(RoleName(o.role)) + " " + to_string(o.id) + " will have " + hours + " contact hours " +
+               (o.week == DateAndTime::NO_DAY ? string("every week") : "in the week of " + DateAndTime::FormatDay(o.week)) +
+               " (limit " + to_string(LimitMinutes(o.role) / 60) + ")";
+    }
+};
+
+/**
+ * @class MakeupRequestQueue
+ * @brief Persistent queue of pending makeup lab requests.
+ * * makeup_requests.dat starts with a "MKQ1" tag followed by records of
+ * [id][live flag][lab id][section][date][start][end]. Submissions are appended,
+ * removals flip the live flag in place (a tombstone), and the file is rewritten
+ * only when tombstones outnumber live records. Pending requests are held in memory
+ * keyed by a stable request ID, so nothing is re-read from disk per operation.
+ */
+class MakeupRequestQueue
+{
+public:
+    struct Entry
+    {
+        int labId;
+        MakeupLabRequest request;
+        long liveOffset; // file offset of this record's live flag
+    };
+
+private:
+    static const int MIN_TOMBSTONES_TO_COMPACT = 16;
+
+    string path;
+    FILE *file;
+    map<int, Entry> pending; // request ID -> entry, in submission order
+    int nextId;
+    int tombstones;
+
+    static void EncodeRecord(ByteWriter &out, int id, bool live, int labId, const MakeupLabRequest &r)
+    {
+        out.WriteInt(id);
+        out.WriteBool(live);
+        out.WriteInt(labId);
+        out.WriteString(r.GetSectionName());
+        out.WriteString(r.GetRequestedDate());
+        out.WriteString(r.GetRequestedStartTime());
+        out.WriteString(r.GetRequestedEndTime());
+    }
+
+    static bool DecodeFields(ByteReader &in, LabDetails *lDetails, int &labId, MakeupLabRequest &r)
+    {
+        string sec, date, start, end;
+        if (!in.ReadInt(labId) || !in.ReadString(sec) || !in.ReadString(date) ||
+            !in.ReadString(start) || !in.ReadString(end))
+            return false;
+        r = MakeupLabRequest(lDetails->FindLab(labId), sec, date, start, end);
+        return true;
+    }
+
+    /**
+     * @brief Writes all pending requests to a fresh file and reopens it for appends.
+     * @return false if the new file could not be installed; the old file and offsets stay in use.
+     */
+    bool Rewrite()
+    {
+        ByteWriter out;
+        out.WriteInt(FILE_TAG);
+        vector<long> offsets;
+        offsets.reserve(pending.size());
+        for (const auto &p : pending)
+        {
+            offsets.push_back(static_cast<long>(out.Size() + sizeof(int)));
+            EncodeRecord(out, p.first, true, p.second.labId, p.second.request);
+        }
+
+        string staged = path + ".tmp";
+        if (!DiskIO::WriteDurably(staged, out.Data()))
+        {
+            remove(staged.c_str());
+            return false;
+        }
+        if (file)
+            fclose(file);
+        bool replaced = DiskIO::Replace(staged, path);
+        file = fopen(path.c_str(), "r+b");
+        if (!replaced)
+        {
+            remove(staged.c_str());
+            return false;
+        }
+
+        size_t i = 0;
+        for (auto &p : pending)
+            p.second.liveOffset = offsets[i++];
+        tombstones = 0;
+        return file != nullptr;
+    }
+
+public:
+    static const int FILE_TAG = 0x31514B4D; // "MKQ1" little-endian
+
+    explicit MakeupRequestQueue(const string &p) : path(p), file(nullptr), nextId(1), tombstones(0) {}
+    ~MakeupRequestQueue()
+    {
+        if (file)
+            fclose(file);
+    }
+
+    /**
+     * @brief Builds the in-memory index. Pre-queue files (no tag) are upgraded in place.
+     */
+    void Load(LabDetails *lDetails)
+    {
+        bool legacy = false;
+        long good = 0, size = 0; // end of the last whole record, and of the file
+        {
+            MappedFile mf(path);
+            ByteReader in(mf.Data(), mf.Size());
+            size = static_cast<long>(mf.Size());
+            int tag = 0;
+            if (mf.Size() > 0 && (!in.ReadInt(tag) || tag != FILE_TAG))
+            {
+                // Old layout: untagged [lab id][section][date][start][end] records
+                legacy = true;
+                ByteReader old(mf.Data(), mf.Size());
+                int labId;
+                MakeupLabRequest r;
+                while (DecodeFields(old, lDetails, labId, r))
+                {
+                    pending.emplace_hint(pending.end(), nextId, Entry{labId, r, 0});
+                    nextId++;
+                }
+            }
+            else if (mf.Size() > 0)
+            {
+                while (true)
+                {
+                    long offset = static_cast<long>(mf.Size()) - static_cast<long>(in.Remaining());
+                    good = offset;
+                    int id, labId;
+                    bool live;
+                    MakeupLabRequest r;
+                    if (!in.ReadInt(id) || !in.ReadBool(live) || !DecodeFields(in, lDetails, labId, r))
+                        break;
+                    if (live)
+                        pending[id] = Entry{labId, r, offset + static_cast<long>(sizeof(int))};
+                    else
+                        tombstones++;
+                    nextId = max(nextId, id + 1);
+                }
+            }
+        }
+
+        if (!legacy && DiskIO::Exists(path))
+        {
+            file = fopen(path.c_str(), "r+b");
+            if (file && good < size)
+            {
+                // A torn last record; appending after it would hide every later submission
+                if (DiskIO::Copy(path, path + ".corrupt"))
+                    cout << "Warning: " << path << ": dropped " << size - good
+                         << " unreadable byte(s) at the end; a copy was kept as " << path << ".corrupt.\n";
+                if (!DiskIO::Truncate(file, good))
+                {
+                    fclose(file);
+                    file = nullptr;
+                }
+            }
+            if (!file)
+                cout << "Warning: could not write " << path << "; makeup requests will not be saved.\n";
+        }
+        else if (!Rewrite())
+        {
+            // Appending tagged records to an untagged file would corrupt it
+            if (file)
+                fclose(file);
+            file = nullptr;
+            cout << "Warning: could not write " << path << "; makeup requests will not be saved.\n";
+        }
+    }
+
+    /**
+     * @brief Appends a request and returns its stable ID.
+     * @return -1 if the record could not be written; the request is not queued then.
+     */
+    int Submit(const MakeupLabRequest &r) { return Submit(r.GetLab() ? r.GetLab()->GetLabId() : -1, r); }
+
+    /**
+     * @brief Same, for a lab ID checked elsewhere (e.g. against a snapshot); the
+     * request may leave its lab unlinked until the queue is next loaded.
+     */
+    int Submit(int labId, const MakeupLabRequest &r)
+    {
+        if (!file || fseek(file, 0, SEEK_END) != 0)
+            return -1;
+        long start = ftell(file);
+        if (start < 0)
+            return -1;
+
+        ByteWriter out;
+        EncodeRecord(out, nextId, true, labId, r);
+        if (fwrite(out.Data().data(), 1, out.Data().size(), file) != out.Data().size() || !DiskIO::Sync(file))
+        {
+            // Leave no partial record behind for the next Load to stop at
+            DiskIO::Truncate(file, start);
+            return -1;
+        }
+        int id = nextId++;
+        pending.emplace_hint(pending.end(), id, Entry{labId, r, start + static_cast<long>(sizeof(int))});
+        return id;
+    }
+
+    /**
+     * @brief Marks a request as handled by tombstoning its record on disk.
+     * @return false if there is no such request or the tombstone could not be written;
+     * the request stays pending in the latter case.
+     */
+    bool Remove(int id)
+    {
+        auto it = pending.find(id);
+        if (it == pending.end())
+            return false;
+
+        char dead = 0;
+        if (!file || fseek(file, it->second.liveOffset, SEEK_SET) != 0 ||
+            fwrite(&dead, 1, 1, file) != 1 || !DiskIO::Sync(file))
+            return false;
+        pending.erase(it);
+
+        // If the rewrite fails the tombstoned file is still valid and stays in use
+        if (++tombstones >= MIN_TOMBSTONES_TO_COMPACT && tombstones > static_cast<int>(pending.size()))
+            Rewrite();
+        return true;
+    }
+
+    const Entry *Find(int id) const
+    {
+        auto it = pending.find(id);
+        return it != pending.end() ? &it->second : nullptr;
+    }
+
+    const map<int, Entry> &GetPending() const { return pending; }
+};
+
+// ==========================================
+// BULK IMPORT
+// ==========================================
+
+/**
+ * @class BulkImporter
+ * @brief Non-interactive loader for infrastructure, faculty and schedule rows.
+ * * The input is one CSV file whose first column names the record type:
+ *   building,<id>,<name>
+ *   room,<id>,<number>,<buildingId>
+ *   teacher,<id>,<name>
+ *   ta,<id>,<name>
+ *   section,<labId>,<courseCode>,<section>,<teacherId>,<buildingId>,<roomId>,<day>,<start>,<end>[,<taId;taId...>]
+ * The file is memory-mapped and split into line ranges that are parsed and
+ * validated in parallel. Commit is serial and runs kind by kind (buildings,
+ * rooms, teachers, TAs, sections) so rows may appear in any order. Foreign keys
+ * for each kind are resolved once per distinct ID before its rows are applied.
+ * Sections that take a teacher or TA past the weekly limit are imported with a warning.
+ */
+class BulkImporter
+{
+public:
+    enum RowKind
+    {
+        ROW_BUILDING = 0,
+        ROW_ROOM = 1,
+        ROW_TEACHER = 2,
+        ROW_TA = 3,
+        ROW_SECTION = 4,
+        ROW_KIND_COUNT = 5
+    };
+
+    struct Report
+    {
+        size_t rows;
+        size_t imported[ROW_KIND_COUNT];
+        vector<pair<int, string>> errors;   // line number, message
+        vector<pair<int, string>> warnings; // imported rows that overload a teacher or TA
+        double parseMillis;
+        double commitMillis;
+    };
+
+    static const size_t MIN_LINES_PER_WORKER = 4096;
+
+private:
+    static constexpr const char *RECORD_FAILED = "could not be recorded (journal write failed)";
+
+    struct Row
+    {
+        RowKind kind;
+        int line;
+        int ids[4]; // kind-specific: see ParseLine
+        string text[2];
+        DateAndTime time;
+        Recurrence rule;
+        vector<int> taIds;
+    };
+
+    struct Chunk
+    {
+        vector<Row> rows;
+        vector<pair<int, string>> errors;
+    };
+
+    static bool ParseInt(string_view s, int &out)
+    {
+        if (s.empty() || s.size() > 10)
+            return false;
+        long v = 0;
+        for (char c : s)
+        {
+            if (c < '0' || c > '9')
+                return false;
+            v = v * 10 + (c - '0');
+        }
+        if (v > INT_MAX)
+            return false;
+        out = static_cast<int>(v);
+        return true;
+    }
+
+    static bool IsValidName(const string &s)
+    {
+        return DataValidator::IsNonEmptyString(s) && DataValidator::DoesNotContainDigits(s);
+    }
+
+    /**
+     * @brief Parses and validates one line. Store lookups are left to the commit pass.
+     * @return Empty string on success, otherwise the error message.
+     */
+    static string ParseLine(string_view line, Row &row)
+    {
+        vector<string_view> f;
+        size_t pos = 0;
+        while (true)
+        {
+            size_t comma = line.find(',', pos);
+            f.push_back(line.substr(pos, comma == string_view::npos ? string_view::npos : comma - pos));
+            if (comma == string_view::npos)
+                break;
+            pos = comma + 1;
+        }
+
+        string_view kind = f[0];
+        if (kind == "building" || kind == "teacher" || kind == "ta")
+        {
+            row.kind = kind == "building" ? ROW_BUILDING : (kind == "teacher" ? ROW_TEACHER : ROW_TA);
+            if (f.size() != 3)
+                return "expected " + string(kind) + ",<id>,<name>";
+            if (!ParseInt(f[1], row.ids[0]) || !DataValidator::IsValidID(row.ids[0]))
+                return "invalid ID";
+            row.text[0] = string(f[2]);
+            if (!IsValidName(row.text[0]))
+                return "name must be non-empty and contain no digits";
+            return "";
+        }
+        if (kind == "room")
+        {
+            row.kind = ROW_ROOM;
+            if (f.size() != 4)
+                return "expected room,<id>,<number>,<buildingId>";
+            if (!ParseInt(f[1], row.ids[0]) || !DataValidator::IsValidID(row.ids[0]) ||
+                !ParseInt(f[3], row.ids[1]) || !DataValidator::IsValidID(row.ids[1]))
+                return "invalid ID";
+            row.text[0] = string(f[2]);
+            if (!DataValidator::IsNonEmptyString(row.text[0]))
+                return "room number cannot be empty";
+            return "";
+        }
+        if (kind == "section")
+        {
+            row.kind = ROW_SECTION;
+            if (f.size() != 10 && f.size() != 11)
+                return "expected section,<labId>,<courseCode>,<section>,<teacherId>,<buildingId>,<roomId>,<day>,<start>,<end>[,<taIds>]";
+            if (!ParseInt(f[1], row.ids[0]) || !ParseInt(f[4], row.ids[1]) || !ParseInt(f[5], row.ids[2]) ||
+                !ParseInt(f[6], row.ids[3]) || !DataValidator::IsValidID(row.ids[0]))
+                return "invalid ID";
+            row.text[0] = string(f[2]);
+            row.text[1] = string(f[3]);
+            if (!DataValidator::IsNonEmptyString(row.text[0]) || !DataValidator::IsNonEmptyString(row.text[1]))
+                return "course code and section cannot be empty";
+            string s(f[8]), e(f[9]);
+            int32_t day;
+            if (!Recurrence::Parse(string(f[7]), day, row.rule))
+                return "day must be YYYY-MM-DD, a weekday, or a weekday with a term";
+            if (!DataValidator::IsValidTime(s) || !DataValidator::IsValidTime(e))
+                return "invalid time format";
+            if (!DataValidator::IsStartBeforeEnd(s, e))
+                return "start must be before end";
+            row.time.SetPacked(day, DateAndTime::ParseMinutes(s), DateAndTime::ParseMinutes(e));
+            if (f.size() == 11)
+            {
+                string_view tas = f[10];
+                while (!tas.empty())
+                {
+                    size_t sep = tas.find(';');
+                    int id;
+                    if (!ParseInt(tas.substr(0, sep), id))
+                        return "invalid TA ID list";
+                    row.taIds.push_back(id);
+                    tas = sep == string_view::npos ? string_view() : tas.substr(sep + 1);
+                }
+            }
+            return "";
+        }
+        return "unknown record type '" + string(kind) + "'";
+    }
+
+    static void ParseRange(const char *data, const vector<size_t> &starts, size_t end, size_t lo, size_t hi, Chunk &out)
+    {
+        for (size_t i = lo; i < hi; i++)
+        {
+            size_t from = starts[i];
+            size_t to = i + 1 < starts.size() ? starts[i + 1] - 1 : end;
+            string_view line(data + from, to - from);
+            if (!line.empty() && line.back() == '\n') // last line of a newline-terminated file
+                line.remove_suffix(1);
+            if (!line.empty() && line.back() == '\r')
+                line.remove_suffix(1);
+            if (line.empty() || line[0] == '#')
+                continue;
+
+            Row row;
+            row.line = static_cast<int>(i + 1);
+            string err = ParseLine(line, row);
+            if (err.empty())
+                out.rows.push_back(std::move(row));
+            else
+                out.errors.push_back({row.line, err});
+        }
+    }
+
+    /**
+     * @brief Looks up each distinct ID referenced by 'rows' once.
+     */
+    template <typename T, typename FindFn>
+    static unordered_map<int, T *> ResolveIds(const vector<const Row *> &rows, int field, FindFn find)
+    {
+        unordered_map<int, T *> resolved;
+        for (const Row *r : rows)
+            if (resolved.find(r->ids[field]) == resolved.end())
+                resolved.emplace(r->ids[field], find(r->ids[field]));
+        return resolved;
+    }
+
+    static string ConflictMessage(const ScheduleConflictIndex::Conflict &c)
+    {
+        return string("conflicts on ") + ScheduleConflictIndex::KindName(c.kind) + " " + to_string(c.resourceId) + " with " + c.first;
+    }
+
+public:
+    /**
+     * @brief Imports 'path' into the stores.
+     * @return false if the file cannot be opened.
+     */
+    static bool Import(const string &path, LabDetails *lDetails, VenueDetails *vDetails, FacultyDetails *fDetails,
+                       ScheduleConflictIndex *conflicts, FacultyWorkload *workload, WriteBatch *batch, Report &report)
+    {
+        report = Report();
+        auto started = chrono::steady_clock::now();
+        MappedFile mf(path);
+        if (!mf.IsOpen())
+            return false;
+
+        const char *data = mf.Data();
+        size_t size = mf.Size();
+        vector<size_t> starts;
+        for (size_t pos = 0; pos < size;)
+        {
+            starts.push_back(pos);
+            const char *nl = static_cast<const char *>(memchr(data + pos, '\n', size - pos));
+            pos = nl ? static_cast<size_t>(nl - data) + 1 : size;
+        }
+
+        // Parse and validate in parallel; chunks are merged in file order
+        vector<Chunk> chunks(ParallelFor::ChunkCount(starts.size(), MIN_LINES_PER_WORKER));
+        ParallelFor::Run(starts.size(), chunks.size(), [&](size_t c, size_t lo, size_t hi)
+                         { ParseRange(data, starts, size, lo, hi, chunks[c]); });
+
+        vector<const Row *> byKind[ROW_KIND_COUNT];
+        for (const auto &chunk : chunks)
+        {
+            for (const auto &row : chunk.rows)
+                byKind[row.kind].push_back(&row);
+            report.errors.insert(report.errors.end(), chunk.errors.begin(), chunk.errors.end());
+            report.rows += chunk.rows.size() + chunk.errors.size();
+        }
+        auto parsed = chrono::steady_clock::now();
+        report.parseMillis = chrono::duration<double, milli>(parsed - started).count();
+
+        if (batch)
+            batch->BeginBatch();
+
+        for (const Row *r : byKind[ROW_BUILDING])
+        {
+            if (vDetails->FindBuilding(r->ids[0]))
+                report.errors.push_back({r->line, "building ID already exists"});
+            else if (!vDetails->AddBuilding(CampusBlock(r->ids[0], r->text[0])))
+                report.errors.push_back({r->line, RECORD_FAILED});
+            else
+                report.imported[ROW_BUILDING]++;
+        }
+
+        auto buildings = ResolveIds<CampusBlock>(byKind[ROW_ROOM], 1, [&](int id)
+                                                 { return vDetails->FindBuilding(id); });
+        for (const Row *r : byKind[ROW_ROOM])
+        {
+            CampusBlock *b = buildings[r->ids[1]];
+            if (vDetails->FindRoom(r->ids[0]))
+                report.errors.push_back({r->line, "room ID already exists"});
+            else if (!b)
+                report.errors.push_back({r->line, "building " + to_string(r->ids[1]) + " not found"});
+            else if (!vDetails->AddRoom(LectureHall(r->ids[0], r->text[0], r->ids[1], b)))
+                report.errors.push_back({r->line, RECORD_FAILED});
+            else
+                report.imported[ROW_ROOM]++;
+        }
+
+        for (const Row *r : byKind[ROW_TEACHER])
+        {
+            if (fDetails->FindTeacher(r->ids[0]))
+                report.errors.push_back({r->line, "teacher ID already exists"});
+            else if (!fDetails->AddTeacher(UniversityTeacher(r->ids[0], r->text[0])))
+                report.errors.push_back({r->line, RECORD_FAILED});
+            else
+                report.imported[ROW_TEACHER]++;
+        }
+        for (const Row *r : byKind[ROW_TA])
+        {
+            if (fDetails->FindTA(r->ids[0]))
+                report.errors.push_back({r->line, "TA ID already exists"});
+            else if (!fDetails->AddTA(TeachingAssistant(r->ids[0], r->text[0])))
+                report.errors.push_back({r->line, RECORD_FAILED});
+            else
+                report.imported[ROW_TA]++;
+        }
+
+        const vector<const Row *> &sections = byKind[ROW_SECTION];
+        auto teachers = ResolveIds<UniversityTeacher>(sections, 1, [&](int id)
+                                                      { return fDetails->FindTeacher(id); });
+        auto sectionBuildings = ResolveIds<CampusBlock>(sections, 2, [&](int id)
+                                                        { return vDetails->FindBuilding(id); });
+        auto rooms = ResolveIds<LectureHall>(sections, 3, [&](int id)
+                                             { return vDetails->FindRoom(id); });
+        unordered_map<int, TeachingAssistant *> tas;
+        for (const Row *r : sections)
+            for (int id : r->taIds)
+                if (tas.find(id) == tas.end())
+                    tas.emplace(id, fDetails->FindTA(id));
+
+        for (const Row *r : sections)
+        {
+            UniversityTeacher *t = teachers[r->ids[1]];
+            CampusBlock *b = sectionBuildings[r->ids[2]];
+            LectureHall *room = rooms[r->ids[3]];
+            string err;
+            if (!t)
+                err = "teacher " + to_string(r->ids[1]) + " not found";
+            else if (!b)
+                err = "building " + to_string(r->ids[2]) + " not found";
+            else if (!room)
+                err = "room " + to_string(r->ids[3]) + " not found";
+            else if (room->GetBuildingId() != r->ids[2])
+                err = "room does not belong to the building";
+            for (int id : r->taIds)
+                if (err.empty() && !tas[id])
+                    err = "TA " + to_string(id) + " not found";
+            if (!err.empty())
+            {
+                report.errors.push_back({r->line, err});
+                continue;
+            }
+
+            ClassSection sec;
+            sec.SetDetails(r->text[1], t, b, room);
+            sec.GetScheduleTime() = r->time;
+            sec.GetRecurrence() = r->rule;
+            for (int id : r->taIds)
+                sec.AddTA(tas[id]);
+
+            vector<ScheduleConflictIndex::Conflict> found = conflicts->CheckSection(r->ids[0], sec);
+            if (!found.empty())
+            {
+                report.errors.push_back({r->line, ConflictMessage(found.front())});
+                continue;
+            }
+            // The workload index sees each committed row, so later rows count the earlier ones
+            vector<FacultyWorkload::Overload> over = workload->CheckSection(sec);
+            if (!lDetails->AddSection(r->ids[0], r->text[0], sec))
+            {
+                report.errors.push_back({r->line, RECORD_FAILED});
+                continue;
+            }
+            for (const auto &o : over)
+                report.warnings.push_back({r->line, FacultyWorkload::Describe(o)});
+            report.imported[ROW_SECTION]++;
+        }
+
+        if (batch)
+            batch->EndBatch();
+
+        sort(report.errors.begin(), report.errors.end());
+        sort(report.warnings.begin(), report.warnings.end());
+        report.commitMillis = chrono::duration<double, milli>(chrono::steady_clock::now() - parsed).count();
+        return true;
+    }
+};
+
+/**
+ * @class TimeSheetImporter
+ * @brief Batch ingestion of attendant time sheets.
+ * * Rows are validated in one pass against a (labId, section) index built once
+ * from the schedule, instead of a FindLab and FindSection scan per entry. Valid
+ * rows are committed together through WorkLogDetails::AddEntries; invalid rows
+ * are reported by line number and skipped. File rows are
+ *   <labId>,<section>,<date>,<leave 0|1>[,<start>,<end>]
+ */
+class TimeSheetImporter
+{
+public:
+    struct Row
+    {
+        int line;
+        int labId;
+        string section;
+        string date;
+        bool leave;
+        string start;
+        string end;
+    };
+
+    struct Report
+    {
+        size_t rows;
+        size_t imported;
+        vector<pair<int, string>> errors; // line number, message
+    };
+
+private:
+    static uint64_t Key(int labId, SymbolId sectionId)
+    {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(labId)) << 32) | sectionId;
+    }
+
+    static string Validate(const Row &row, const unordered_set<uint64_t> &scheduled)
+    {
+        SymbolId secId;
+        if (!SymbolTable::Instance().Find(row.section, secId) || !scheduled.count(Key(row.labId, secId)))
+            return "section " + row.section + " of lab " + to_string(row.labId) + " is not scheduled";
+        if (!DataValidator::IsValidDate(row.date))
+            return "invalid date";
+        if (row.leave)
+            return "";
+        if (!DataValidator::IsValidTime(row.start) || !DataValidator::IsValidTime(row.end))
+            return "invalid time format";
+        if (!DataValidator::IsStartBeforeEnd(row.start, row.end))
+            return "start must be before end";
+        return "";
+    }
+
+    /**
+     * @brief True for the "labId" column name, in any case and ignoring surrounding spaces.
+     */
+    static bool IsHeader(const string &field)
+    {
+        static const string name = "labid";
+        size_t first = field.find_first_not_of(" \t");
+        size_t last = field.find_last_not_of(" \t");
+        if (first == string::npos || last - first + 1 != name.size())
+            return false;
+        for (size_t i = 0; i < name.size(); i++)
+            if (tolower(static_cast<unsigned char>(field[first + i])) != name[i])
+                return false;
+        return true;
+    }
+
+public:
+    /**
+     * @brief Validates 'rows' and commits the valid ones as a single batch.
+     * * Counts and errors are added to 'report', so a file's parse errors can be
+     * collected first.
+     */
+    static void Ingest(const vector<Row> &rows, LabDetails *lDetails, WorkLogDetails *logDetails, Report &report)
+    {
+        unordered_set<uint64_t> scheduled;
+        for (const auto &lab : lDetails->GetAllLabs())
+            for (const auto &sec : lab.GetSections())
+                scheduled.insert(Key(lab.GetLabId(), sec.GetSectionId()));
+
+        vector<WorkLog> accepted;
+        vector<int> acceptedLines;
+        accepted.reserve(rows.size());
+        for (const auto &row : rows)
+        {
+            string err = Validate(row, scheduled);
+            if (!err.empty())
+            {
+                report.errors.push_back({row.line, err});
+                continue;
+            }
+            WorkLog entry;
+            entry.SetLabId(row.labId);
+            entry.SetSectionName(row.section);
+            entry.GetActualTiming().Set(row.date, row.leave ? "" : row.start, row.leave ? "" : row.end);
+            entry.SetIsLeave(row.leave);
+            accepted.push_back(std::move(entry));
+            acceptedLines.push_back(row.line);
+        }
+
+        report.rows += rows.size();
+        if (!accepted.empty() && !logDetails->AddEntries(accepted))
+        {
+            for (int line : acceptedLines)
+                report.errors.push_back({line, "could not be recorded (journal write failed)"});
+            accepted.clear();
+        }
+        report.imported += accepted.size();
+        sort(report.errors.begin(), report.errors.end());
+    }
+
+    /**
+     * @brief Reads 'path' and ingests it. Blank lines, '#' comments and a leading
+     * "labId,..." header row are skipped; any other non-numeric lab ID is an error.
+     * @return false if the file cannot be opened.
+     */
+    static bool IngestFile(const string &path, LabDetails *lDetails, WorkLogDetails *logDetails, Report &report)
+    {
+        report = Report();
+        ifstream in(path);
+        if (!in)
+            return false;
+
+        vector<Row> rows;
+        string line;
+        bool headerAllowed = true;
+        for (int lineNo = 1; getline(in, line); lineNo++)
+        {
+            if (!line.empty() && line.back() == '\r')
+                line.pop_back();
+            if (line.empty() || line[0] == '#')
+                continue;
+
+            vector<string> fields;
+            size_t pos = 0;
+            while (true)
+            {
+                size_t comma = line.find(',', pos);
+                fields.push_back(line.substr(pos, comma == string::npos ? string::npos : comma - pos));
+                if (comma == string::npos)
+                    break;
+                pos = comma + 1;
+            }
+
+            Row row;
+            row.line = lineNo;
+            char *end = nullptr;
+            long labId = strtol(fields[0].c_str(), &end, 10);
+            bool numeric = !fields[0].empty() && *end == '\0';
+            if (headerAllowed && IsHeader(fields[0]))
+            {
+                headerAllowed = false;
+                continue;
+            }
+            headerAllowed = false;
+
+            if (fields.size() != 4 && fields.size() != 6)
+                report.errors.push_back({lineNo, "expected <labId>,<section>,<date>,<leave>[,<start>,<end>]"});
+            else if (!numeric || labId < 0 || labId > INT_MAX || !DataValidator::IsValidID(static_cast<int>(labId)))
+                report.errors.push_back({lineNo, "invalid lab ID"});
+            else if (fields[3] != "0" && fields[3] != "1")
+                report.errors.push_back({lineNo, "leave must be 0 or 1"});
+            else if (fields[3] == "0" && fields.size() != 6)
+                report.errors.push_back({lineNo, "start and end are required unless on leave"});
+            else
+            {
+                row.labId = static_cast<int>(labId);
+                row.section = fields[1];
+                row.date = fields[2];
+                row.leave = fields[3] == "1";
+                if (fields.size() == 6)
+                {
+                    row.start = fields[4];
+                    row.end = fields[5];
+                }
+                rows.push_back(std::move(row));
+            }
+        }
+
+        report.rows = report.errors.size(); // rows rejected while parsing
+        Ingest(rows, lDetails, logDetails, report);
+        return true;
+    }
+};
+
+// ==========================================
+// ACTOR ROLES
+// ==========================================
+
+class Person
+{
+protected:
+    string roleName;
+
+public:
+    Person(const string &n) : roleName(n) {}
+    virtual ~Person() {}
+};
+
+class HOD : public Person
+{
+private:
+    /**
+     * @brief Calculates the duration in hours of a timing slot.
+     */
+    float CalculateHours(const DateAndTime &t)
+    {
+        return (float)t.GetDurationMinutes() / 60.0f;
+    }
+
+    /**
+     * @brief Resolves a week prompt into an inclusive day range.
+     * @param input Any YYYY-MM-DD date in the week (Monday-Sunday), or "all".
+     * @return false if the input is neither.
+     */
+    bool ParseWeekRange(const string &input, int32_t &fromDay, int32_t &toDay)
+    {
+        if (input == "all")
+        {
+            fromDay = INT32_MIN;
+            toDay = INT32_MAX;
+            return true;
+        }
+        if (!DataValidator::IsValidDate(input))
+            return false;
+
+        DateAndTime t;
+        t.SetDate(input);
+        fromDay = t.GetDay() - t.GetWeekday();
+        toDay = fromDay + 6;
+        return true;
+    }
+
+    /**
+     * @brief Displays the full schedule for the week, grouped by Day.
+     * The grouping and text come from the view maintained as sections are added.
+     */
+    void GenerateCompleteWeeklySchedule(LabDetails *lDetails, WeeklyScheduleView *view)
+    {
+        cout << "\nComplete Lab Schedule - Entire Week\n";
+        cout << string(40, '=') << "\n";
+
+        if (lDetails->GetAllLabs().empty())
+        {
+            cout << "No labs scheduled for the week.\n";
+            return;
+        }
+
+        cout << view->Render();
+        cout << string(40, '=') << "\n";
+    }
+
+    /**
+     * @brief Lists the concrete sessions held in one calendar week.
+     * Each section's recurrence is expanded over just that week, so terms and skipped dates apply.
+     */
+    void GenerateSessionsForWeek(LabDetails *lDetails)
+    {
+        string weekInput;
+        int32_t fromDay, toDay;
+        cout << "Enter any date in the week (YYYY-MM-DD): ";
+        InputOutput::SafeReadString(weekInput);
+        if (!DataValidator::IsValidDate(weekInput) || !ParseWeekRange(weekInput, fromDay, toDay))
+        {
+            cout << "Invalid date.\n";
+            return;
+        }
+
+        struct Session
+        {
+            int32_t day;
+            const CourseLaboratory *lab;
+            const ClassSection *sec;
+        };
+        vector<Session> sessions;
+        for (const auto &lab : lDetails->GetAllLabs())
+            for (const auto &sec : lab.GetSections())
+                sec.GetRecurrence().ForEachOccurrence(sec.GetScheduleTime().GetDay(), fromDay, toDay, [&](int32_t day)
+                {
+                    sessions.push_back({day, &lab, &sec});
+                    return true;
+                });
+
+        if (sessions.empty())
+        {
+            cout << "No sessions in this week.\n";
+            return;
+        }
+        stable_sort(sessions.begin(), sessions.end(), [](const Session &a, const Session &b)
+                    { return make_pair(a.day, a.sec->GetScheduleTime().GetStartMinute()) < make_pair(b.day, b.sec->GetScheduleTime().GetStartMinute()); });
+
+        cout << "\nSessions for week of " << DateAndTime::FormatDay(fromDay) << "\n";
+        cout << left << setw(12) << "Date" << setw(11) << "Day" << setw(13) << "Time" << setw(8) << "LabID"
+             << setw(10) << "Course" << setw(12) << "Section" << "Room" << endl;
+        for (const auto &s : sessions)
+        {
+            const DateAndTime &t = s.sec->GetScheduleTime();
+            cout << left << setw(12) << DateAndTime::FormatDay(s.day) << setw(11) << DateAndTime::FormatDay(-(DateAndTime::WeekdayOf(s.day) + 1))
+                 << setw(13) << t.GetStartTime() + "-" + t.GetEndTime() << setw(8) << s.lab->GetLabId()
+                 << setw(10) << s.lab->GetCourseCode() << setw(12) << s.sec->GetSectionName()
+                 << (s.sec->GetRoom() ? s.sec->GetRoom()->GetRoomNumber() : "N/A") << endl;
+        }
+    }
+
+    /**
+     * @brief Room and building occupancy for a week, with an hour-by-weekday campus heatmap.
+     */
+    void GenerateRoomUtilization(VenueDetails *vDetails, RoomUtilization *usage)
+    {
+        string weekInput;
+        int32_t fromDay, toDay;
+        cout << "Enter any date in the week (YYYY-MM-DD) or 'typical': ";
+        InputOutput::SafeReadString(weekInput);
+        if (weekInput == "typical")
+            usage->SetWeek(DateAndTime::NO_DAY);
+        else if (DataValidator::IsValidDate(weekInput) && ParseWeekRange(weekInput, fromDay, toDay))
+            usage->SetWeek(fromDay);
+        else
+        {
+            cout << "Invalid week. Use a YYYY-MM-DD date or 'typical'.\n";
+            return;
+        }
+
+        auto started = chrono::steady_clock::now();
+        size_t rebuilt = usage->Refresh();
+        double millis = chrono::duration<double, milli>(chrono::steady_clock::now() - started).count();
+
+        vector<RoomUtilization::RoomStats> table = usage->RoomTable(vDetails);
+        if (table.empty())
+        {
+            cout << "No rooms registered.\n";
+            return;
+        }
+
+        int32_t week = usage->GetWeek();
+        cout << "\nRoom Utilization, Mon-Fri 08:00-20:00, "
+             << (week == DateAndTime::NO_DAY ? "typical week" : "week of " + DateAndTime::FormatDay(week)) << "\n";
+        cout << left << setw(8) << "RoomID" << setw(12) << "Room" << setw(14) << "Building" << setw(8) << "Hours" << "Util %" << endl;
+
+        map<int, pair<long, long>> byBuilding; // building ID -> busy, capacity minutes
+        vector<int> roomIds;
+        cout << fixed << setprecision(1);
+        for (const auto &r : table)
+        {
+            LectureHall *room = vDetails->FindRoom(r.roomId);
+            CampusBlock *block = vDetails->FindBuilding(r.buildingId);
+            cout << left << setw(8) << r.roomId << setw(12) << (room ? room->GetRoomNumber() : "N/A")
+                 << setw(14) << (block ? block->GetName() : "N/A") << setw(8) << r.busyMinutes / 60.0
+                 << 100.0 * r.busyMinutes / r.windowMinutes << endl;
+            byBuilding[r.buildingId].first += r.busyMinutes;
+            byBuilding[r.buildingId].second += r.windowMinutes;
+            roomIds.push_back(r.roomId);
+        }
+
+        cout << "\nBy Building\n";
+        for (const auto &b : byBuilding)
+        {
+            CampusBlock *block = vDetails->FindBuilding(b.first);
+            cout << left << setw(22) << (block ? block->GetName() : "Building " + to_string(b.first))
+                 << 100.0 * b.second.first / b.second.second << "%" << endl;
+        }
+
+        // Share of rooms busy in each hour of the teaching day
+        array<array<int, 24>, 7> grid = usage->HourlyBusy(roomIds);
+        cout << "\nCampus occupancy % by hour\n" << left << setw(7) << "Hour";
+        for (int d = 0; d < 7; d++)
+            cout << setw(7) << DateAndTime::FormatDay(-(d + 1)).substr(0, 3);
+        cout << endl;
+        for (int h = RoomUtilization::WINDOW_START / 60; h < RoomUtilization::WINDOW_END / 60; h++)
+        {
+            cout << left << setw(7) << DateAndTime::FormatMinutes(static_cast<uint16_t>(h * 60));
+            for (int d = 0; d < 7; d++)
+                cout << setw(7) << 100.0 * grid[d][h] / (60.0 * roomIds.size());
+            cout << endl;
+        }
+        cout << "Recomputed " << rebuilt << " rooms in " << millis << " ms\n";
+        cout.unsetf(ios::fixed);
+        cout << setprecision(6);
+
+        string path;
+        cout << "Export heatmap CSV to (blank to skip): ";
+        InputOutput::SafeReadString(path);
+        if (path.empty())
+            return;
+        if (usage->ExportHeatmap(path, vDetails))
+            cout << "Heatmap written to " << path << ".\n";
+        else
+            cout << "Cannot write " << path << ".\n";
+    }
+
+    static void PrintReconciliationRow(const string &label, const HoursReconciliation::Totals &t)
+    {
+        cout << left << setw(14) << label << setw(10) << t.sessions << setw(8) << t.leaves
+             << setw(11) << t.plannedMinutes / 60.0 << setw(10) << t.actualMinutes / 60.0
+             << setw(8) << t.lateStarts << t.earlyFinishes << endl;
+    }
+
+    static void PrintReconciliationHeader(const string &title, const string &keyName)
+    {
+        cout << "\n" << title << "\n"
+             << left << setw(14) << keyName << setw(10) << "Sessions" << setw(8) << "Leaves"
+             << setw(11) << "Planned h" << setw(10) << "Actual h" << setw(8) << "Late" << "Early" << endl;
+    }
+
+    /**
+     * @brief Compares each time sheet against its section's scheduled times.
+     */
+    void GeneratePlannedVsActual(LabDetails *lDetails, WorkLogDetails *logDetails)
+    {
+        string weekInput;
+        int32_t fromDay, toDay;
+        cout << "Enter any date in the week (YYYY-MM-DD) or 'all': ";
+        InputOutput::SafeReadString(weekInput);
+        if (!ParseWeekRange(weekInput, fromDay, toDay))
+        {
+            cout << "Invalid week. Use a YYYY-MM-DD date or 'all'.\n";
+            return;
+        }
+
+        HoursReconciliation::Report report = HoursReconciliation::Run(lDetails, logDetails, fromDay, toDay);
+        if (report.total.sessions == 0)
+        {
+            cout << "No time sheets to reconcile.\n";
+            return;
+        }
+
+        cout << fixed << setprecision(1);
+        PrintReconciliationHeader("Planned vs Actual by Lab", "LabID");
+        for (const auto &e : report.byLab)
+            PrintReconciliationRow(to_string(e.first), e.second);
+        PrintReconciliationHeader("By Teacher", "TeacherID");
+        for (const auto &e : report.byTeacher)
+            PrintReconciliationRow(e.first ? to_string(e.first) : "Unassigned", e.second);
+        PrintReconciliationHeader("By Week", "Week of");
+        for (const auto &e : report.byWeek)
+            PrintReconciliationRow(e.first == DateAndTime::NO_DAY ? "Undated" : DateAndTime::FormatDay(e.first), e.second);
+        PrintReconciliationRow("All", report.total);
+
+        cout << "Late/early means more than " << HoursReconciliation::GRACE_MINUTES << " minutes off the schedule";
+        if (report.total.lateStarts || report.total.earlyFinishes)
+            cout << " (" << report.total.lateMinutes / 60.0 << " h late, " << report.total.earlyMinutes / 60.0 << " h early)";
+        cout << ".\n";
+        if (report.unmatched)
+            cout << report.unmatched << " time sheets refer to sections that are not scheduled.\n";
+        cout << "Reconciled in " << report.millis << " ms\n";
+        cout.unsetf(ios::fixed);
+        cout << setprecision(6);
+    }
+
+    /**
+     * @brief Contact hours and sections of one teacher or TA, from the workload index.
+     */
+    void GenerateFacultyWorkload(LabDetails *lDetails, FacultyWorkload *workload)
+    {
+        int roleChoice, id;
+        string weekInput;
+        int32_t fromDay = DateAndTime::NO_DAY, toDay;
+        cout << "1. Teacher\n2. TA\nSelect: ";
+        InputOutput::SafeReadInt(roleChoice);
+        FacultyWorkload::Role role = roleChoice == 2 ? FacultyWorkload::TA : FacultyWorkload::TEACHER;
+        cout << "ID: ";
+        InputOutput::SafeReadInt(id);
+        cout << "Enter any date in the week (YYYY-MM-DD) or 'typical': ";
+        InputOutput::SafeReadString(weekInput);
+        if (weekInput != "typical" && (!DataValidator::IsValidDate(weekInput) || !ParseWeekRange(weekInput, fromDay, toDay)))
+        {
+            cout << "Invalid week. Use a YYYY-MM-DD date or 'typical'.\n";
+            return;
+        }
+
+        const auto &sections = workload->SectionsOf(role, id);
+        if (sections.empty())
+        {
+            cout << "No sections assigned to " << FacultyWorkload::RoleName(role) << " " << id << ".\n";
+            return;
+        }
+
+        int minutes = workload->WeeklyMinutes(role, id, fromDay);
+        cout << "\n" << FacultyWorkload::RoleName(role) << " " << id << ": " << minutes / 60.0 << " contact hours "
+             << (fromDay == DateAndTime::NO_DAY ? string("in a typical week") : "in the week of " + DateAndTime::FormatDay(fromDay))
+             << " (limit " << FacultyWorkload::LimitMinutes(role) / 60 << ")\n";
+        if (minutes > FacultyWorkload::LimitMinutes(role))
+            cout << "Over-allocated.\n";
+
+        for (const auto &a : sections)
+        {
+            CourseLaboratory *lab = lDetails->FindLab(a.labId);
+            const ClassSection *sec = lab ? lab->FindSection(a.sectionId) : nullptr;
+            if (!sec)
+                continue;
+            cout << "  Lab " << a.labId << " " << lab->GetCourseCode() << " Sec " << sec->GetSectionName() << " | "
+                 << sec->GetDayText() << " " << sec->GetScheduleTime().GetStartTime() << "-" << sec->GetScheduleTime().GetEndTime() << "\n";
+        }
+    }
+
+    void GenerateWeeklyTimeSheetReport(LabDetails *lDetails, WorkLogDetails *logDetails)
+    {
+        cout << "\nFilled Time Sheets Report\n";
+        cout << string(40, '=') << "\n";
+
+        string weekInput;
+        int32_t fromDay, toDay;
+        cout << "Enter any date in the week (YYYY-MM-DD) or 'all': ";
+        InputOutput::SafeReadString(weekInput);
+        if (!ParseWeekRange(weekInput, fromDay, toDay))
+        {
+            cout << "Invalid week. Use a YYYY-MM-DD date or 'all'.\n";
+            return;
+        }
+
+        // Rows are printed straight from the date index as they are visited
+        size_t rows = 0;
+        logDetails->ForEachInDateRange(fromDay, toDay, [&rows](const WorkLog &log)
+        {
+            if (rows++ == 0)
+                cout << left << setw(8) << "LabID" << setw(12) << "Section" << setw(15) << "Date" << "Status" << endl;
+            cout << left << setw(8) << log.GetLabId() << setw(12) << log.GetSectionName()
+                 << setw(15) << log.GetActualTiming().GetDate()
+                 << (log.GetIsLeave() ? "LEAVE" : "PRESENT") << endl;
+        });
+
+        if (rows == 0)
+            cout << "No entries found.\n";
+    }
+
+    void GenerateLabSpecificTimeSheet(LabDetails *lDetails, WorkLogDetails *logDetails)
+    {
+        int labId;
+        cout << "Enter Lab ID: ";
+        InputOutput::SafeReadInt(labId);
+        if (!lDetails->FindLab(labId))
+        {
+            cout << "Error: Lab ID not found.\n";
+            return;
+        }
+
+        size_t rows = 0;
+        logDetails->ForEachForLab(labId, INT32_MIN, INT32_MAX, [&rows, labId](const WorkLog &log)
+        {
+            if (rows++ == 0)
+                cout << "Logs for Lab " << labId << ":\n";
+            cout << "Sec: " << log.GetSectionName() << " | Date: " << log.GetActualTiming().GetDate()
+                 << " | " << (log.GetIsLeave() ? "LEAVE" : "PRESENT") << endl;
+        });
+
+        if (rows == 0)
+            cout << "No logs for this lab.\n";
+    }
+
+    void GenerateLabHoursSummary(WorkLogDetails *logDetails)
+    {
+        vector<LabLogSummary> summary = logDetails->SummarizeByLab();
+        if (summary.empty())
+        {
+            cout << "No logs recorded.\n";
+            return;
+        }
+
+        cout << "\nLab Hours Summary\n";
+        cout << left << setw(8) << "LabID" << setw(10) << "Entries" << setw(8) << "Leaves"
+             << setw(10) << "Leave %" << "Hours" << endl;
+
+        LabLogSummary total = {0, 0, 0, 0};
+        for (const auto &s : summary)
+        {
+            float leavePct = s.entries ? 100.0f * s.leaves / s.entries : 0.0f;
+            cout << left << setw(8) << s.labId << setw(10) << s.entries << setw(8) << s.leaves
+                 << setw(10) << fixed << setprecision(1) << leavePct
+                 << setprecision(2) << s.presentMinutes / 60.0f << endl;
+            total.entries += s.entries;
+            total.leaves += s.leaves;
+            total.presentMinutes += s.presentMinutes;
+        }
+
+        float totalPct = total.entries ? 100.0f * total.leaves / total.entries : 0.0f;
+        cout << left << setw(8) << "All" << setw(10) << total.entries << setw(8) << total.leaves
+             << setw(10) << setprecision(1) << totalPct
+             << setprecision(2) << total.presentMinutes / 60.0f << endl;
+        cout.unsetf(ios::fixed);
+        cout << setprecision(6);
+    }
+
+public:
+    HOD() : Person("HOD") {}
+    void ShowMenu(LabDetails *lDetails, WorkLogDetails *wDetails, VenueDetails *vDetails, WeeklyScheduleView *view, RoomUtilization *usage, FacultyWorkload *workload)
+    {
+        int choice;
+        while (true)
+        {
+            cout << "\n--- HOD DASHBOARD ---\n";
+            cout << "1. Weekly Schedule\n2. Weekly Time Sheet Report\n3. Lab Specific Report\n4. Lab Hours Summary\n5. Sessions in a Week\n6. Room Utilization\n7. Planned vs Actual Hours\n8. Faculty Workload\n9. Logout\nSelect: ";
+            InputOutput::SafeReadInt(choice);
+            if (choice == 1)
+                GenerateCompleteWeeklySchedule(lDetails, view);
+            else if (choice == 2)
+                GenerateWeeklyTimeSheetReport(lDetails, wDetails);
+            else if (choice == 3)
+                GenerateLabSpecificTimeSheet(lDetails, wDetails);
+            else if (choice == 4)
+                GenerateLabHoursSummary(wDetails);
+            else if (choice == 5)
+                GenerateSessionsForWeek(lDetails);
+            else if (choice == 6)
+                GenerateRoomUtilization(vDetails, usage);
+            else if (choice == 7)
+                GeneratePlannedVsActual(lDetails, wDetails);
+            else if (choice == 8)
+                GenerateFacultyWorkload(lDetails, workload);
+            else
+                return;
+        }
+    }
+};
+
+class AcademicOfficer : public Person
+{
+private:
+    static const size_t MAKEUP_SUGGESTIONS = 5;
+
+    /**
+     * @brief Prints any double bookings a candidate section would cause.
+     * @return true if the section is conflict-free and may be committed.
+     */
+    bool ReportConflicts(ScheduleConflictIndex *conflicts, int labId, const ClassSection &sec)
+    {
+        vector<ScheduleConflictIndex::Conflict> found = conflicts->CheckSection(labId, sec);
+        if (found.empty())
+            return true;
+
+        cout << "Cannot schedule, conflicts with existing bookings:\n";
+        for (const auto &c : found)
+            ScheduleConflictIndex::PrintConflict(c);
+        return false;
+    }
+
+    /**
+     * @brief Warns when a section takes its teacher or a TA past the weekly contact-hour limit.
+     */
+    void ReportOverloads(FacultyWorkload *workload, const ClassSection &sec)
+    {
+        for (const auto &o : workload->CheckSection(sec))
+            cout << "Warning: " << FacultyWorkload::Describe(o) << ".\n";
+    }
+
+public:
+    AcademicOfficer() : Person("Academic Officer") {}
+
+    void AuditScheduleConflicts(ScheduleConflictIndex *conflicts)
+    {
+        vector<ScheduleConflictIndex::Conflict> found = conflicts->AuditAll();
+        if (found.empty())
+        {
+            cout << "\nNo conflicts found.\n";
+            return;
+        }
+
+        cout << "\nSchedule Conflicts (" << found.size() << ")\n";
+        for (const auto &c : found)
+            ScheduleConflictIndex::PrintConflict(c);
+    }
+
+    void AddBuilding(VenueDetails *vDetails)
+    {
+        int id;
+        string name;
         // Validate ID
         do
         {
-            cout << "Enter Building ID (>0): ";
-            InputOutput::SafeReadInt(id);
-            if (!DataValidator::IsValidID(id))
-                cout << "Invalid ID. Must be > 0.\n";
-        } while (!DataValidator::IsValidID(id));
+            cout << "Enter Building ID (>0): ";
+            InputOutput::SafeReadInt(id);
+            if (!DataValidator::IsValidID(id))
+                cout << "Invalid ID. Must be > 0.\n";
+        } while (!DataValidator::IsValidID(id));
+
+        // Check duplication
+        if (vDetails->FindBuilding(id))
+        {
+            cout << "ID exists.\n";
+            return;
+        }
+
+        // Validate Name (No empty, no digits)
+        do
+        {
+            cout << "Enter Building Name: ";
+            InputOutput::SafeReadString(name);
+            if (!DataValidator::IsNonEmptyString(name))
+                cout << "Name cannot be empty.\n";
+            else if (!DataValidator::DoesNotContainDigits(name))
+                cout << "Name cannot contain numbers.\n";
+        } while (!DataValidator::IsNonEmptyString(name) || !DataValidator::DoesNotContainDigits(name));
+
+        if (vDetails->AddBuilding(CampusBlock(id, name)))
+            cout << "Building Added.\n";
+        else
+            cout << "Error: could not record the change in the journal.\n";
+    }
+
+    void AddRoom(VenueDetails *vDetails)
+    {
+        int id, bId;
+        string num;
+        do
+        {
+            cout << "Enter Room ID (>0): ";
+            InputOutput::SafeReadInt(id);
+            if (!DataValidator::IsValidID(id))
+                cout << "Invalid ID. Must be > 0.\n";
+        } while (!DataValidator::IsValidID(id));
+
+        if (vDetails->FindRoom(id))
+        {
+            cout << "ID exists.\n";
+            return;
+        }
+
+        do
+        {
+            cout << "Enter Room Number/Name: ";
+            InputOutput::SafeReadString(num);
+            if (!DataValidator::IsNonEmptyString(num))
+                cout << "Cannot be empty.\n";
+        } while (!DataValidator::IsNonEmptyString(num));
+
+        do
+        {
+            cout << "Enter Building ID (>0): ";
+            InputOutput::SafeReadInt(bId);
+            if (!DataValidator::IsValidID(bId))
+                cout << "Invalid ID.\n";
+        } while (!DataValidator::IsValidID(bId));
+
+        CampusBlock *b = vDetails->FindBuilding(bId);
+        if (!b)
+        {
+            cout << "Building ID not found.\n";
+            return;
+        }
+
+        if (vDetails->AddRoom(LectureHall(id, num, bId, b)))
+            cout << "Room Added.\n";
+        else
+            cout << "Error: could not record the change in the journal.\n";
+    }
+
+    void AddTeacher(FacultyDetails *fDetails)
+    {
+        int id;
+        string name;
+        do
+        {
+            cout << "Enter Teacher ID (>0): ";
+            InputOutput::SafeReadInt(id);
+            if (!DataValidator::IsValidID(id))
+                cout << "Invalid ID.\n";
+        } while (!DataValidator::IsValidID(id));
+
+        if (fDetails->FindTeacher(id))
+        {
+            cout << "ID exists.\n";
+            return;
+        }
+
+        // Validate Name (No empty, no digits)
+        do
+        {
+            cout << "Enter Name: ";
+            InputOutput::SafeReadString(name);
+            if (!DataValidator::IsNonEmptyString(name))
+                cout << "Cannot be empty.\n";
+            else if (!DataValidator::DoesNotContainDigits(name))
+                cout << "Name cannot contain numbers.\n";
+        } while (!DataValidator::IsNonEmptyString(name) || !DataValidator::DoesNotContainDigits(name));
+
+        if (fDetails->AddTeacher(UniversityTeacher(id, name)))
+            cout << "Teacher Added.\n";
+        else
+            cout << "Error: could not record the change in the journal.\n";
+    }
+
+    void AddTA(FacultyDetails *fDetails)
+    {
+        int id;
+        string name;
+        do
+        {
+            cout << "Enter TA ID (>0): ";
+            InputOutput::SafeReadInt(id);
+            if (!DataValidator::IsValidID(id))
+                cout << "Invalid ID.\n";
+        } while (!DataValidator::IsValidID(id));
+
+        if (fDetails->FindTA(id))
+        {
+            cout << "ID exists.\n";
+            return;
+        }
+
+        // Validate Name (No empty, no digits)
+        do
+        {
+            cout << "Enter Name: ";
+            InputOutput::SafeReadString(name);
+            if (!DataValidator::IsNonEmptyString(name))
+                cout << "Cannot be empty.\n";
+            else if (!DataValidator::DoesNotContainDigits(name))
+                cout << "Name cannot contain numbers.\n";
+        } while (!DataValidator::IsNonEmptyString(name) || !DataValidator::DoesNotContainDigits(name));
+
+        if (fDetails->AddTA(TeachingAssistant(id, name)))
+            cout << "TA Added.\n";
+        else
+            cout << "Error: could not record the change in the journal.\n";
+    }
+
+    void ViewInfrastructure(VenueDetails *v, FacultyDetails *f)
+    {
+        cout << "\n--- VIEW INFRASTRUCTURE ---\n";
+        cout << "1. Buildings\n2. Rooms\n3. Teachers\n4. TAs\nSelect: ";
+        int choice;
+        InputOutput::SafeReadInt(choice);
+
+        if (choice == 1)
+        {
+            auto &bldgs = v->GetAllBuildings();
+            if (bldgs.empty())
+                cout << "No buildings recorded.\n";
+            else
+                for (auto &b : bldgs)
+                    cout << "ID: " << b.GetId() << " | Name: " << b.GetName() << endl;
+        }
+        else if (choice == 2)
+        {
+            auto &rooms = v->GetAllRooms();
+            if (rooms.empty())
+                cout << "No rooms recorded.\n";
+            else
+                for (auto &r : rooms)
+                    cout << "ID: " << r.GetId() << " | Room: " << r.GetRoomNumber() << " | Building ID: " << r.GetBuildingId() << endl;
+        }
+        else if (choice == 3)
+        {
+            auto &teachers = f->GetAllTeachers();
+            if (teachers.empty())
+                cout << "No teachers recorded.\n";
+            else
+                for (auto &t : teachers)
+                    cout << "ID: " << t.GetId() << " | Name: " << t.GetName() << endl;
+        }
+        else if (choice == 4)
+        {
+            auto &tas = f->GetAllTAs();
+            if (tas.empty())
+                cout << "No TAs recorded.\n";
+            else
+                for (auto &t : tas)
+                    cout << "ID: " << t.GetId() << " | Name: " << t.GetName() << endl;
+        }
+    }
+
+    void ViewCompleteLabDetails(LabDetails *lDetails)
+    {
+        cout << "\nComplete Lab Schedule\n";
+        deque<CourseLaboratory> &labs = lDetails->GetAllLabs();
+        if (labs.empty())
+        {
+            cout << "No labs scheduled.\n";
+            return;
+        }
+
+        for (const auto &lab : labs)
+        {
+            cout << "\nLab ID: " << lab.GetLabId() << " | Code: " << lab.GetCourseCode() << "\n";
+            for (const auto &sec : lab.GetSections())
+            {
+                cout << "  Section: " << sec.GetSectionName() << "\n";
+                cout << "  Instructor: " << (sec.GetTeacher() ? sec.GetTeacher()->GetName() : "Unassigned") << "\n";
+                cout << "  Room: " << (sec.GetRoom() ? sec.GetRoom()->GetRoomNumber() : "N/A") << "\n";
+                cout << "  Time: " << sec.GetDayText() << " " << sec.GetScheduleTime().GetStartTime() << "-" << sec.GetScheduleTime().GetEndTime() << "\n";
+            }
+        }
+    }
+
+    void ScheduleSection(LabDetails *lDetails, VenueDetails *vDetails, FacultyDetails *fDetails, ScheduleConflictIndex *conflicts, FacultyWorkload *workload)
+    {
+        int labId, teacherId, bId, rId, taCount;
+        string code, secName, day, s, e;
+
+        do
+        {
+            cout << "Lab ID: ";
+            InputOutput::SafeReadInt(labId);
+            if (!DataValidator::IsValidID(labId))
+                cout << "Invalid ID.\n";
+        } while (!DataValidator::IsValidID(labId));
+        do
+        {
+            cout << "Course Code: ";
+            InputOutput::SafeReadString(code);
+            if (!DataValidator::IsNonEmptyString(code))
+                cout << "Cannot be empty.\n";
+        } while (!DataValidator::IsNonEmptyString(code));
+        do
+        {
+            cout << "Section Name: ";
+            InputOutput::SafeReadString(secName);
+            if (!DataValidator::IsNonEmptyString(secName))
+                cout << "Cannot be empty.\n";
+        } while (!DataValidator::IsNonEmptyString(secName));
+
+        UniversityTeacher *t = nullptr;
+        CampusBlock *b = nullptr;
+        LectureHall *r = nullptr;
+
+        do
+        {
+            cout << "Teacher ID: ";
+            InputOutput::SafeReadInt(teacherId);
+            t = fDetails->FindTeacher(teacherId);
+            if (!t)
+                cout << "Teacher ID not found.\n";
+        } while (!t);
+
+        do
+        {
+            cout << "Building ID: ";
+            InputOutput::SafeReadInt(bId);
+            b = vDetails->FindBuilding(bId);
+            if (!b)
+                cout << "Building ID not found.\n";
+        } while (!b);
+
+        do
+        {
+            cout << "Room ID: ";
+            InputOutput::SafeReadInt(rId);
+            r = vDetails->FindRoom(rId);
+            if (!r)
+                cout << "Room ID not found.\n";
+            else if (r->GetBuildingId() != bId)
+            {
+                cout << "Room does not belong to the selected building.\n";
+                r = nullptr;
+            }
+        } while (!r);
+
+        int32_t slotDay;
+        Recurrence rule;
+        while (true)
+        {
+            cout << "Day/Date (YYYY-MM-DD, Weekday, or Weekday FROM..TO [except DATE ...]): ";
+            InputOutput::SafeReadString(day);
+            if (Recurrence::Parse(day, slotDay, rule))
+                break;
+            cout << "Use a YYYY-MM-DD date or a weekday name, optionally followed by a term such as\n"
+                 << "2024-01-08..2024-05-10 and 'except' with the skipped dates.\n";
+        }
+
+        while (true)
+        {
+            cout << "Start (HH:MM): ";
+            InputOutput::SafeReadString(s);
+            cout << "End (HH:MM): ";
+            InputOutput::SafeReadString(e);
+            if (!DataValidator::IsValidTime(s) || !DataValidator::IsValidTime(e))
+            {
+                cout << "Invalid time format. Use HH:MM.\n";
+            }
+            else if (!DataValidator::IsStartBeforeEnd(s, e))
+            {
+                cout << "Start time must be strictly before End time.\n";
+            }
+            else
+            {
+                break;
+            }
+        }
+
+        ClassSection sec;
+        sec.SetDetails(secName, t, b, r);
+        sec.GetScheduleTime().SetPacked(slotDay, DateAndTime::ParseMinutes(s), DateAndTime::ParseMinutes(e));
+        sec.GetRecurrence() = rule;
+
+        cout << "Num TAs: ";
+        InputOutput::SafeReadInt(taCount);
+        for (int i = 0; i < taCount; i++)
+        {
+            int taId;
+            cout << "TA ID: ";
+            InputOutput::SafeReadInt(taId);
+            TeachingAssistant *ta = fDetails->FindTA(taId);
+            if (ta)
+                sec.AddTA(ta);
+            else
+                cout << "TA ID " << taId << " not found, skipping.\n";
+        }
+
+        if (!ReportConflicts(conflicts, labId, sec))
+            return;
+        ReportOverloads(workload, sec);
+
+        if (lDetails->AddSection(labId, code, sec))
+            cout << "Scheduled.\n";
+        else
+            cout << "Error: could not record the change in the journal.\n";
+    }
+
+    void ViewMakeupRequests(MakeupRequestQueue *queue)
+    {
+        const auto &requests = queue->GetPending();
+        if (requests.empty())
+        {
+            cout << "\nNo makeup requests.\n";
+            return;
+        }
+
+        cout << "\nMakeup Requests\n";
+        for (const auto &p : requests)
+        {
+            const MakeupLabRequest &req = p.second.request;
+            cout << "Request " << p.first << " | Lab: " << p.second.labId << " | Sec: " << req.GetSectionName()
+                 << " | Date: " << req.GetRequestedDate() << " " << req.GetRequestedStartTime() << "-" << req.GetRequestedEndTime() << "\n";
+        }
+    }
+
+    void ScheduleMakeupLab(LabDetails *lDetails, VenueDetails *vDetails, FacultyDetails *fDetails, ScheduleConflictIndex *conflicts, MakeupRequestQueue *queue, MakeupSlotAdvisor *advisor, FacultyWorkload *workload)
+    {
+        const auto &requests = queue->GetPending();
+        if (requests.empty())
+        {
+            cout << "\nNo makeup requests.\n";
+            return;
+        }
+
+        cout << "\nAvailable Makeup Requests\n";
+        for (const auto &p : requests)
+            cout << "Request " << p.first << ". Lab ID: " << p.second.labId << ", Sec: " << p.second.request.GetSectionName() << endl;
+
+        int requestId;
+        cout << "\nSelect request ID (0 to cancel): ";
+        InputOutput::SafeReadInt(requestId);
+        const MakeupRequestQueue::Entry *entry = queue->Find(requestId);
+        if (!entry)
+            return;
+
+        MakeupLabRequest selected = entry->request;
+        if (!selected.GetLab())
+            selected.SetLab(lDetails->FindLab(entry->labId)); // submitted unlinked by the server
+        if (!selected.GetLab())
+        {
+            cout << "Lab for this request no longer exists.\n";
+            return;
+        }
+
+        ClassSection makeupSec;
+        bool placed = false;
+        CourseLaboratory *lab = selected.GetLab();
+        const ClassSection *base = lab->FindSection(selected.GetSectionId());
+        if (base)
+        {
+            auto started = chrono::steady_clock::now();
+            vector<MakeupSlotAdvisor::Suggestion> options =
+                advisor->Suggest(vDetails, lab->GetLabId(), *base, selected.GetRequestedTiming(), MAKEUP_SUGGESTIONS);
+            double micros = chrono::duration<double, micro>(chrono::steady_clock::now() - started).count();
+
+            if (!options.empty())
+            {
+                cout << "\nSuggested Slots (found in " << static_cast<long>(micros) << " us)\n";
+                for (size_t i = 0; i < options.size(); i++)
+                {
+                    const MakeupSlotAdvisor::Suggestion &o = options[i];
+                    cout << "Option " << i + 1 << ". Room " << vDetails->FindRoom(o.roomId)->GetRoomNumber() << " | "
+                         << DateAndTime::FormatDay(o.day) << " " << DateAndTime::FormatMinutes(static_cast<uint16_t>(o.start))
+                         << "-" << DateAndTime::FormatMinutes(static_cast<uint16_t>(o.end))
+                         << (o.distance == 0 ? " (as requested)" : "") << "\n";
+                }
+
+                int pick;
+                cout << "Pick a slot (0 to enter room manually): ";
+                InputOutput::SafeReadInt(pick);
+                if (pick >= 1 && pick <= static_cast<int>(options.size()))
+                {
+                    const MakeupSlotAdvisor::Suggestion &o = options[pick - 1];
+                    LectureHall *r = vDetails->FindRoom(o.roomId);
+                    makeupSec.SetDetails(selected.GetSectionName() + "_MAKEUP", base->GetTeacher(), vDetails->FindBuilding(r->GetBuildingId()), r);
+                    makeupSec.GetScheduleTime().SetPacked(o.day, static_cast<uint16_t>(o.start), static_cast<uint16_t>(o.end));
+                    for (auto *ta : base->GetAssistants())
+                        makeupSec.AddTA(ta);
+                    placed = true;
+                }
+            }
+            else
+                cout << "No free slot within " << MakeupSlotAdvisor::SEARCH_DAYS << " days of the request.\n";
+        }
+
+        if (!placed)
+        {
+            int teacherId, bId, rId, taCount;
+
+            UniversityTeacher *t = nullptr;
+            CampusBlock *b = nullptr;
+            LectureHall *r = nullptr;
+
+            do
+            {
+                cout << "Instructor ID: ";
+                InputOutput::SafeReadInt(teacherId);
+                t = fDetails->FindTeacher(teacherId);
+                if (!t)
+                    cout << "Teacher not found.\n";
+            } while (!t);
+
+            do
+            {
+                cout << "Building ID: ";
+                InputOutput::SafeReadInt(bId);
+                b = vDetails->FindBuilding(bId);
+                if (!b)
+                    cout << "Building not found.\n";
+            } while (!b);
+
+            do
+            {
+                cout << "Room ID: ";
+                InputOutput::SafeReadInt(rId);
+                r = vDetails->FindRoom(rId);
+                if (!r)
+                    cout << "Room not found.\n";
+                else if (r->GetBuildingId() != bId)
+                {
+                    cout << "Room not in building.\n";
+                    r = nullptr;
+                }
+            } while (!r);
+
+            makeupSec.SetDetails(selected.GetSectionName() + "_MAKEUP", t, b, r);
+            makeupSec.GetScheduleTime() = selected.GetRequestedTiming();
+
+            cout << "Num TAs: ";
+            InputOutput::SafeReadInt(taCount);
+            for (int i = 0; i < taCount; i++)
+            {
+                int taId;
+                cout << "TA ID: ";
+                InputOutput::SafeReadInt(taId);
+                TeachingAssistant *ta = fDetails->FindTA(taId);
+                if (ta)
+                    makeupSec.AddTA(ta);
+            }
+        }
+
+        if (!ReportConflicts(conflicts, selected.GetLab()->GetLabId(), makeupSec))
+            return;
+        ReportOverloads(workload, makeupSec);
+
+        if (!lDetails->AddSection(selected.GetLab()->GetLabId(), selected.GetLab()->GetCourseCode(), makeupSec))
+        {
+            cout << "Error: could not record the change in the journal.\n";
+            return;
+        }
+
+        if (!queue->Remove(requestId))
+            cout << "Warning: could not mark request " << requestId << " as handled; it is still pending.\n";
+        cout << "Makeup Scheduled.\n";
+    }
+
+    /**
+     * @brief Places a file of unscheduled sections into weekly slots automatically.
+     * * Every placement still goes through the conflict index before it is committed.
+     */
+    void AutoScheduleSections(LabDetails *lDetails, VenueDetails *vDetails, FacultyDetails *fDetails, ScheduleConflictIndex *conflicts, FacultyWorkload *workload, WriteBatch *batch)
+    {
+        string path;
+        cout << "Section list file (labId,courseCode,section,teacherId,minutes[,taId;taId...]): ";
+        InputOutput::SafeReadString(path);
+
+        vector<SectionPlacementSolver::Request> requests;
+        vector<int> badLines;
+        if (!SectionPlacementSolver::ReadRequests(path, requests, badLines))
+        {
+            cout << "Cannot open " << path << ".\n";
+            return;
+        }
+        for (int line : badLines)
+            cout << "Skipping malformed line " << line << ".\n";
+        if (requests.empty())
+        {
+            cout << "No sections to place.\n";
+            return;
+        }
+
+        // Placements are weekly, so their load does not depend on the slot chosen;
+        // earlier placements of this run count through 'planned'
+        FacultyWorkload planned;
+        auto withinLimits = [&](const SectionPlacementSolver::Request &req) -> string
+        {
+            ClassSection probe;
+            probe.SetDetails(req.sectionName, fDetails->FindTeacher(req.teacherId), nullptr, nullptr);
+            probe.GetScheduleTime().SetPacked(-1, 0, static_cast<uint16_t>(req.durationMinutes));
+            for (int id : req.taIds)
+                probe.AddTA(fDetails->FindTA(id));
+            vector<FacultyWorkload::Overload> over = workload->CheckSection(probe, &planned);
+            if (!over.empty())
+                return "would exceed the workload limit: " + FacultyWorkload::Describe(over.front());
+            CourseLaboratory lab;
+            lab.SetLabId(req.labId);
+            planned.OnSectionAdded(lab, probe);
+            return "";
+        };
+
+        SectionPlacementSolver solver(lDetails, vDetails);
+        SectionPlacementSolver::Result result = solver.Solve(requests, fDetails, withinLimits);
+
+        batch->BeginBatch();
+        size_t committed = 0;
+        long startTotal = 0;
+        int perDay[SectionPlacementSolver::WORK_DAYS] = {0};
+        set<int> roomsUsed;
+        for (const auto &p : result.placed)
+        {
+            const SectionPlacementSolver::Request &req = requests[p.request];
+            LectureHall *r = vDetails->FindRoom(p.roomId);
+            ClassSection sec;
+            sec.SetDetails(req.sectionName, fDetails->FindTeacher(req.teacherId), vDetails->FindBuilding(r->GetBuildingId()), r);
+            sec.GetScheduleTime().SetPacked(-(p.weekday + 1), static_cast<uint16_t>(p.startMinute), static_cast<uint16_t>(p.endMinute));
+            for (int id : req.taIds)
+                sec.AddTA(fDetails->FindTA(id));
+
+            if (!conflicts->CheckSection(req.labId, sec).empty())
+            {
+                result.unplaced.push_back({p.request, "rejected by conflict check"});
+                continue;
+            }
+            for (const auto &o : workload->CheckSection(sec))
+                cout << "Warning: Lab " << req.labId << " / Sec " << req.sectionName << ": "
+                     << FacultyWorkload::Describe(o) << ".\n";
+            if (!lDetails->AddSection(req.labId, req.courseCode, sec))
+            {
+                result.unplaced.push_back({p.request, "could not be recorded (journal write failed)"});
+                continue;
+            }
+            committed++;
+            startTotal += p.startMinute;
+            perDay[p.weekday]++;
+            roomsUsed.insert(p.roomId);
+        }
+        batch->EndBatch();
+
+        cout << "\nAuto-Schedule: placed " << committed << " of " << requests.size() << " sections in "
+             << fixed << setprecision(1) << result.solveMillis << " ms (" << solver.GetWorkerCount() << " workers)\n";
+        cout.unsetf(ios::fixed);
+        cout << setprecision(6);
+        if (committed > 0)
+        {
+            cout << "Rooms used: " << roomsUsed.size()
+                 << " | Mean start: " << DateAndTime::FormatMinutes(static_cast<uint16_t>(startTotal / static_cast<long>(committed)))
+                 << " | Per day:";
+            for (int d = 0; d < SectionPlacementSolver::WORK_DAYS; d++)
+                cout << " " << DateAndTime::FormatDay(-(d + 1)).substr(0, 3) << " " << perDay[d];
+            cout << "\n";
+        }
+        for (const auto &u : result.unplaced)
+            cout << "  Unplaced Lab " << requests[u.first].labId << " / Sec " << requests[u.first].sectionName
+                 << ": " << u.second << "\n";
+    }
+
+    void BulkImport(LabDetails *lDetails, VenueDetails *vDetails, FacultyDetails *fDetails, ScheduleConflictIndex *conflicts, FacultyWorkload *workload, WriteBatch *batch)
+    {
+        static const size_t MAX_ERRORS_SHOWN = 20;
+        static const char *kindNames[] = {"Buildings", "Rooms", "Teachers", "TAs", "Sections"};
+
+        string path;
+        cout << "Import file (CSV, one record per line): ";
+        InputOutput::SafeReadString(path);
+
+        BulkImporter::Report report;
+        if (!BulkImporter::Import(path, lDetails, vDetails, fDetails, conflicts, workload, batch, report))
+        {
+            cout << "Cannot open " << path << ".\n";
+            return;
+        }
+
+        size_t imported = 0;
+        cout << "\nImported:";
+        for (int k = 0; k < BulkImporter::ROW_KIND_COUNT; k++)
+        {
+            cout << " " << kindNames[k] << " " << report.imported[k];
+            imported += report.imported[k];
+        }
+        double seconds = (report.parseMillis + report.commitMillis) / 1000.0;
+        cout << "\n"
+             << imported << " of " << report.rows << " rows in " << fixed << setprecision(1)
+             << report.parseMillis << " ms parse + " << report.commitMillis << " ms commit";
+        if (seconds > 0)
+            cout << " (" << static_cast<long>(report.rows / seconds) << " rows/s)";
+        cout << "\n";
+        cout.unsetf(ios::fixed);
+        cout << setprecision(6);
+
+        for (size_t i = 0; i < report.errors.size() && i < MAX_ERRORS_SHOWN; i++)
+            cout << "  Line " << report.errors[i].first << ": " << report.errors[i].second << "\n";
+        if (report.errors.size() > MAX_ERRORS_SHOWN)
+            cout << "  ... " << report.errors.size() - MAX_ERRORS_SHOWN << " more errors\n";
+        for (size_t i = 0; i < report.warnings.size() && i < MAX_ERRORS_SHOWN; i++)
+            cout << "  Warning, line " << report.warnings[i].first << ": " << report.warnings[i].second << ".\n";
+        if (report.warnings.size() > MAX_ERRORS_SHOWN)
+            cout << "  ... " << report.warnings.size() - MAX_ERRORS_SHOWN << " more warnings\n";
+    }
+
+    void ShowMenu(LabDetails *l, VenueDetails *v, FacultyDetails *f, ScheduleConflictIndex *c, MakeupRequestQueue *q, MakeupSlotAdvisor *a, FacultyWorkload *k, WriteBatch *w)
+    {
+        while (true)
+        {
+            cout << "\n--- ACADEMIC OFFICER DASHBOARD ---\n";
+            cout << "1. Add Infrastructure (Building/Room/Faculty)\n";
+            cout << "2. Schedule Section\n";
+            cout << "3. View Complete Lab Schedule\n";
+            cout << "4. View Existing Infrastructure\n";
+            cout << "5. View Makeup Requests\n";
+            cout << "6. Schedule Makeup Lab\n";
+            cout << "7. Audit Schedule Conflicts\n";
+            cout << "8. Auto-Schedule Sections from File\n";
+            cout << "9. Bulk Import from File\n";
+            cout << "10. Logout\n";
+            cout << "Select: ";
+
+            int ch;
+            InputOutput::SafeReadInt(ch);
+
+            if (ch == 1)
+            {
+                cout << "\n--- ADD INFRASTRUCTURE ---\n";
+                cout << "1. Add Building\n";
+                cout << "2. Add Room\n";
+                cout << "3. Add Teacher\n";
+                cout << "4. Add Teaching Assistant\n";
+                cout << "0. Back\n";
+                cout << "Select: ";
+
+                int sub;
+                InputOutput::SafeReadInt(sub);
+                if (sub == 1)
+                    AddBuilding(v);
+                else if (sub == 2)
+                    AddRoom(v);
+                else if (sub == 3)
+                    AddTeacher(f);
+                else if (sub == 4)
+                    AddTA(f);
+            }
+            else if (ch == 2)
+                ScheduleSection(l, v, f, c, k);
+            else if (ch == 3)
+                ViewCompleteLabDetails(l);
+            else if (ch == 4)
+                ViewInfrastructure(v, f);
+            else if (ch == 5)
+                ViewMakeupRequests(q);
+            else if (ch == 6)
+                ScheduleMakeupLab(l, v, f, c, q, a, k);
+            else if (ch == 7)
+                AuditScheduleConflicts(c);
+            else if (ch == 8)
+                AutoScheduleSections(l, v, f, c, k, w);
+            else if (ch == 9)
+                BulkImport(l, v, f, c, k, w);
+            else
+                return;
+        }
+    }
+};
+
+class Instructor : public Person
+{
+private:
+    void RequestMakeupLab(LabDetails *lDetails, MakeupRequestQueue *queue, int labId, const string &secName, const string &date, const string &s, const string &e)
+    {
+        MakeupLabRequest request(lDetails->FindLab(labId), secName, date, s, e);
+        int id = queue->Submit(request);
+        if (id < 0)
+            cout << "Error: could not save the request.\n";
+        else
+            cout << "Request Submitted (ID " << id << ").\n";
+    }
+
+public:
+    Instructor() : Person("Instructor") {}
+    void ShowMenu(LabDetails *lDetails, MakeupRequestQueue *queue)
+    {
+        int choice;
+        while (true)
+        {
+            cout << "\n--- INSTRUCTOR ---\n1. Request Makeup\n2. Logout\nSelect: ";
+            InputOutput::SafeReadInt(choice);
+            if (choice == 1)
+            {
+                int id;
+                string sec, date, s, e;
+                CourseLaboratory *l = nullptr;
+                ClassSection *section = nullptr;
+
+                // Ensure we only makeup scheduled labs
+                do
+                {
+                    cout << "Lab ID: ";
+                    InputOutput::SafeReadInt(id);
+                    l = lDetails->FindLab(id);
+                    if (!l)
+                        cout << "Error: Lab ID not found. Can only request makeup for scheduled labs.\n";
+                } while (!l);
+
+                do
+                {
+                    cout << "Section: ";
+                    InputOutput::SafeReadString(sec);
+                    section = l->FindSection(sec);
+                    if (!section)
+                        cout << "Error: Section not found in this Lab.\n";
+                } while (!section);
+
+                do
+                {
+                    cout << "Date (YYYY-MM-DD): ";
+                    InputOutput::SafeReadString(date);
+                    if (!DataValidator::IsValidDate(date))
+                        cout << "Invalid Date Format or Value (Use YYYY-MM-DD).\n";
+                } while (!DataValidator::IsValidDate(date));
+
+                while (true)
+                {
+                    cout << "Start (HH:MM): ";
+                    InputOutput::SafeReadString(s);
+                    cout << "End (HH:MM): ";
+                    InputOutput::SafeReadString(e);
+                    if (!DataValidator::IsValidTime(s) || !DataValidator::IsValidTime(e))
+                        cout << "Invalid time format.\n";
+                    else if (!DataValidator::IsStartBeforeEnd(s, e))
+                        cout << "Start time must be strictly before End time.\n";
+                    else
+                        break;
+                }
+
+                RequestMakeupLab(lDetails, queue, id, sec, date, s, e);
+            }
+            else
+                return;
+        }
+    }
+};
+
+class Attendant : public Person
+{
+private:
+    bool IsLabSectionScheduled(LabDetails *lDetails, int labId, const string &secName)
+    {
+        CourseLaboratory *lab = lDetails->FindLab(labId);
+        if (!lab)
+            return false;
+        ClassSection *sec = lab->FindSection(secName);
+        return sec != nullptr;
+    }
+
+    void ViewScheduledLabs(LabDetails *lDetails)
+    {
+        cout << "\n--- SCHEDULED LABS ---\n";
+        deque<CourseLaboratory> &labs = lDetails->GetAllLabs();
+        if (labs.empty())
+        {
+            cout << "No labs scheduled.\n";
+            return;
+        }
+
+        for (const auto &lab : labs)
+        {
+            cout << "\nCourse: " << lab.GetCourseCode() << " (ID: " << lab.GetLabId() << ")\n";
+            for (const auto &sec : lab.GetSections())
+            {
+                cout << "  Sec: " << sec.GetSectionName() << " | Time: " << sec.GetDayText() << " " << sec.GetScheduleTime().GetStartTime() << "-" << sec.GetScheduleTime().GetEndTime() << "\n";
+            }
+        }
+    }
+
+    void FillTimeSheet(LabDetails *lDetails, WorkLogDetails *logDetails, int labId, const string &secName, const string &d, const string &s, const string &e, bool leave)
+    {
+        WorkLog entry;
+        entry.SetLabId(labId);
+        entry.SetSectionName(secName);
+        entry.GetActualTiming().Set(d, s, e);
+        entry.SetIsLeave(leave);
+        if (logDetails->AddEntry(entry))
+            cout << "Time Sheet Filled.\n";
+        else
+            cout << "Error: could not record the change in the journal.\n";
+    }
+
+    void FillTimeSheetsFromFile(LabDetails *lDetails, WorkLogDetails *logDetails)
+    {
+        static const size_t MAX_ERRORS_SHOWN = 20;
+
+        string path;
+        cout << "Time sheet file (labId,section,date,leave[,start,end]): ";
+        InputOutput::SafeReadString(path);
+
+        TimeSheetImporter::Report report;
+        if (!TimeSheetImporter::IngestFile(path, lDetails, logDetails, report))
+        {
+            cout << "Cannot open " << path << ".\n";
+            return;
+        }
+
+        cout << "\nFilled " << report.imported << " of " << report.rows << " time sheets.\n";
+        for (size_t i = 0; i < report.errors.size() && i < MAX_ERRORS_SHOWN; i++)
+            cout << "  Line " << report.errors[i].first << ": " << report.errors[i].second << "\n";
+        if (report.errors.size() > MAX_ERRORS_SHOWN)
+            cout << "  ... " << report.errors.size() - MAX_ERRORS_SHOWN << " more errors\n";
+    }
+
+public:
+    Attendant() : Person("Attendant") {}
+    void ShowMenu(LabDetails *lDetails, WorkLogDetails *logDetails)
+    {
+        int choice;
+        while (true)
+        {
+            cout << "\n--- ATTENDANT ---\n1. View Labs\n2. Fill Time Sheet\n3. Fill Time Sheets from File\n4. Logout\nSelect: ";
+            InputOutput::SafeReadInt(choice);
+            if (choice == 1)
+                ViewScheduledLabs(lDetails);
+            else if (choice == 2)
+            {
+                int id, leave;
+                string sec, d, s, e;
+                CourseLaboratory *l = nullptr;
+                ClassSection *section = nullptr;
+
+                // Ensure filling time sheet only for scheduled labs
+                do
+                {
+                    cout << "Lab ID: ";
+                    InputOutput::SafeReadInt(id);
+                    l = lDetails->FindLab(id);
+                    if (!l)
+                        cout << "Error: Lab ID not found.\n";
+                } while (!l);
+
+                do
+                {
+                    cout << "Section: ";
+                    InputOutput::SafeReadString(sec);
+                    section = l->FindSection(sec);
+                    if (!section)
+                        cout << "Error: Section not found.\n";
+                } while (!section);
+
+                do
+                {
+                    cout << "Date (YYYY-MM-DD): ";
+                    InputOutput::SafeReadString(d);
+                    if (!DataValidator::IsValidDate(d))
+                        cout << "Invalid Date Format or Value.\n";
+                } while (!DataValidator::IsValidDate(d));
+
+                cout << "Leave? (1/0): ";
+                InputOutput::SafeReadInt(leave);
+
+                if (!leave)
+                {
+                    while (true)
+                    {
+                        cout << "Start (HH:MM): ";
+                        InputOutput::SafeReadString(s);
+                        cout << "End (HH:MM): ";
+                        InputOutput::SafeReadString(e);
+                        if (!DataValidator::IsValidTime(s) || !DataValidator::IsValidTime(e))
+                            cout << "Invalid time format.\n";
+                        else if (!DataValidator::IsStartBeforeEnd(s, e))
+                            cout << "Start time must be strictly before End time.\n";
+                        else
+                            break;
+                    }
+                }
+                FillTimeSheet(lDetails, logDetails, id, sec, d, s, e, leave);
+            }
+            else if (choice == 3)
+                FillTimeSheetsFromFile(lDetails, logDetails);
+            else
+                return;
+        }
+    }
+};
+
+/**
+ * @class RecordCodec
+ * @brief Encodes and decodes entities in the shared .dat record layout.
+ * * Used for both the snapshot files and the change journal. Interned names are
+ * written inline, except in snapshot blocks, where the writer passes its
+ * BlockFile::Writer and a name becomes an index into the block's name table
+ * (the reader passes the table from BlockFile::ReadNames).
+ */
+class RecordCodec
+{
+private:
+    static void WriteName(ByteWriter &out, SymbolId id, BlockFile::Writer *names)
+    {
+        if (names)
+            out.WriteInt(names->Name(id));
+        else
+            out.WriteString(SymbolTable::Instance().Name(id));
+    }
+
+    static bool ReadName(ByteReader &in, const vector<SymbolId> *names, SymbolId &id)
+    {
+        if (!names)
+        {
+            string name;
+            if (!in.ReadString(name))
+                return false;
+            id = SymbolTable::Instance().Intern(name);
+            return true;
+        }
+        int index;
+        if (!in.ReadInt(index) || index < 0 || static_cast<size_t>(index) >= names->size())
+            return false;
+        id = (*names)[index];
+        return true;
+    }
+
+public:
+    static void WriteBuilding(ByteWriter &out, const CampusBlock &b, BlockFile::Writer *names = nullptr)
+    {
+        out.WriteInt(b.GetId());
+        WriteName(out, b.GetNameId(), names);
+    }
+
+    static bool ReadBuilding(ByteReader &in, CampusBlock &b, const vector<SymbolId> *names = nullptr)
+    {
+        int id;
+        SymbolId name;
+        if (!in.ReadInt(id) || !ReadName(in, names, name))
+            return false;
+        b = CampusBlock(id, name);
+        return true;
+    }
+
+    static void WriteRoom(ByteWriter &out, const LectureHall &r, BlockFile::Writer *names = nullptr)
+    {
+        out.WriteInt(r.GetId());
+        WriteName(out, r.GetRoomNumberId(), names);
+        out.WriteInt(r.GetBuildingId());
+    }
+
+    static bool ReadRoom(ByteReader &in, VenueDetails *v, LectureHall &r, const vector<SymbolId> *names = nullptr)
+    {
+        int id, bId;
+        SymbolId num;
+        if (!in.ReadInt(id) || !ReadName(in, names, num) || !in.ReadInt(bId))
+            return false;
+        r = LectureHall(id, num, bId, v->FindBuilding(bId));
+        return true;
+    }
+
+    // Teachers and TAs share the (id, name) layout
+    static void WritePerson(ByteWriter &out, int id, const string &name)
+    {
+        out.WriteInt(id);
+        out.WriteString(name);
+    }
+
+    static bool ReadPerson(ByteReader &in, int &id, string &name)
+    {
+        return in.ReadInt(id) && in.ReadString(name);
+    }
+
+    static void WriteSection(ByteWriter &out, const ClassSection &sec, BlockFile::Writer *names = nullptr)
+    {
+        WriteName(out, sec.GetSectionId(), names);
+        out.WriteInt(sec.GetTeacher() ? sec.GetTeacher()->GetId() : -1);
+        out.WriteInt(sec.GetBuilding() ? sec.GetBuilding()->GetId() : -1);
+        out.WriteInt(sec.GetRoom() ? sec.GetRoom()->GetId() : -1);
+        out.WriteString(sec.GetDayText());
+        out.WriteString(sec.GetScheduleTime().GetStartTime());
+        out.WriteString(sec.GetScheduleTime().GetEndTime());
+
+        auto &tas = sec.GetAssistants();
+        out.WriteInt(static_cast<int>(tas.size()));
+        for (auto *ta : tas)
+            out.WriteInt(ta ? ta->GetId() : -1);
+    }
+
+    /**
+     * @brief IDs a stored section refers to, kept until the venue and faculty stores are ready.
+     */
+    struct SectionRefs
+    {
+        int teacherId;
+        int buildingId;
+        int roomId;
+        vector<int> taIds;
+    };
+
+    /**
+     * @brief Decodes a section without resolving its references (no store access).
+     */
+    static bool ReadSectionRefs(ByteReader &in, ClassSection &sec, SectionRefs &refs,
+                                const vector<SymbolId> *names = nullptr)
+    {
+        SymbolId secName;
+        string d, s, e;
+        int taCount;
+        if (!ReadName(in, names, secName) || !in.ReadInt(refs.teacherId) || !in.ReadInt(refs.buildingId) ||
+            !in.ReadInt(refs.roomId) || !in.ReadString(d) || !in.ReadString(s) || !in.ReadString(e) ||
+            !in.ReadInt(taCount))
+            return false;
+
+        sec = ClassSection();
+        sec.SetSectionId(secName);
+        sec.RestoreDayText(d);
+        sec.GetScheduleTime().SetStartTime(s);
+        sec.GetScheduleTime().SetEndTime(e);
+
+        refs.taIds.clear();
+        for (int k = 0; k < taCount; k++)
+        {
+            int taId;
+            if (!in.ReadInt(taId))
+                return false;
+            refs.taIds.push_back(taId);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Points a decoded section at its teacher, venue and TAs; unknown IDs stay unset.
+     */
+    static void ResolveSection(ClassSection &sec, const SectionRefs &refs, VenueDetails *v, FacultyDetails *f)
+    {
+        sec.SetTeacher(f->FindTeacher(refs.teacherId));
+        sec.SetBuilding(v->FindBuilding(refs.buildingId));
+        sec.SetRoom(v->FindRoom(refs.roomId));
+        for (int taId : refs.taIds)
+        {
+            TeachingAssistant *ta = f->FindTA(taId);
+            if (ta)
+                sec.AddTA(ta);
+        }
+    }
+
+    static bool ReadSection(ByteReader &in, VenueDetails *v, FacultyDetails *f, ClassSection &sec)
+    {
+        SectionRefs refs;
+        if (!ReadSectionRefs(in, sec, refs))
+            return false;
+        ResolveSection(sec, refs, v, f);
+        return true;
+    }
+
+    /**
+     * @brief Steps over one lab record; used to find chunk boundaries in schedule.dat.
+     */
+    static bool SkipLab(ByteReader &in)
+    {
+        int id, sCount;
+        if (!in.ReadInt(id) || !in.SkipString() || !in.ReadInt(sCount))
+            return false;
+        for (int j = 0; j < sCount; j++)
+        {
+            int taCount;
+            if (!in.SkipString() || !in.Skip(3 * sizeof(int)) || !in.SkipString() || !in.SkipString() ||
+                !in.SkipString() || !in.ReadInt(taCount) || taCount < 0 || !in.Skip(static_cast<size_t>(taCount) * sizeof(int)))
+                return false;
+        }
+        return true;
+    }
+
+    static void WriteLab(ByteWriter &out, const CourseLaboratory &lab, BlockFile::Writer *names = nullptr)
+    {
+        out.WriteInt(lab.GetLabId());
+        WriteName(out, lab.GetCourseCodeId(), names);
+        auto &secs = lab.GetSections();
+        out.WriteInt(static_cast<int>(secs.size()));
+        for (auto &sec : secs)
+            WriteSection(out, sec, names);
+    }
+
+    static bool ReadLab(ByteReader &in, VenueDetails *v, FacultyDetails *f, CourseLaboratory &lab)
+    {
+        int id, sCount;
+        string code;
+        if (!in.ReadInt(id) || !in.ReadString(code) || !in.ReadInt(sCount))
+            return false;
+
+        lab = CourseLaboratory();
+        lab.SetLabId(id);
+        lab.SetCourseCode(code);
+        ClassSection sec;
+        for (int j = 0; j < sCount; j++)
+        {
+            if (!ReadSection(in, v, f, sec))
+                return false;
+            lab.AddSection(sec);
+        }
+        return true;
+    }
+
+    /**
+     * @brief ReadLab without store access; refs[i] belongs to the lab's i-th section.
+     */
+    static bool ReadLabRefs(ByteReader &in, CourseLaboratory &lab, vector<SectionRefs> &refs,
+                            const vector<SymbolId> *names = nullptr)
+    {
+        int id, sCount;
+        SymbolId code;
+        if (!in.ReadInt(id) || !ReadName(in, names, code) || !in.ReadInt(sCount))
+            return false;
+
+        lab = CourseLaboratory();
+        lab.SetLabId(id);
+        lab.SetCourseCodeId(code);
+        refs.clear();
+        ClassSection sec;
+        for (int j = 0; j < sCount; j++)
+        {
+            refs.emplace_back();
+            if (!ReadSectionRefs(in, sec, refs.back(), names))
+                return false;
+            lab.AddSection(sec);
+        }
+        return true;
+    }
+
+    static void WriteLog(ByteWriter &out, const WorkLog &log)
+    {
+        out.WriteInt(log.GetLabId());
+        out.WriteString(log.GetSectionName());
+        out.WriteBool(log.GetIsLeave());
+        out.WriteString(log.GetActualTiming().GetDate());
+        out.WriteString(log.GetActualTiming().GetStartTime());
+        out.WriteString(log.GetActualTiming().GetEndTime());
+    }
+
+    static bool ReadLog(ByteReader &in, WorkLog &log)
+    {
+        int id;
+        bool leave;
+        string secName, d, s, e;
+        if (!in.ReadInt(id) || !in.ReadString(secName) || !in.ReadBool(leave) ||
+            !in.ReadString(d) || !in.ReadString(s) || !in.ReadString(e))
+            return false;
+
+        log.SetLabId(id);
+        log.SetSectionName(secName);
+        log.SetIsLeave(leave);
+        log.GetActualTiming().Set(d, s, e);
+        return true;
+    }
+};
+
+/**
+ * @class ChangeJournal
+ * @brief Append-only write-ahead log of store mutations.
+ * * The file starts with a header ("SDJL" magic, format version) and each record
+ * is [body length][CRC-32C of body][body], where the body is [type][payload].
+ * Replay stops at the first record that is cut short or fails its checksum, and
+ * Open() truncates the file there so later appends do not land behind a torn
+ * tail. A CHECKPOINT record marks that a complete snapshot has been staged in
+ * *.tmp files and is being installed. Files without the magic are the original
+ * unchecked [type][payload length][payload] layout (version 1), which Open()
+ * rewrites in the current one.
+ */
+class ChangeJournal : public WriteBatch
+{
+public:
+    enum RecordType
+    {
+        REC_BUILDING = 1,
+        REC_ROOM = 2,
+        REC_TEACHER = 3,
+        REC_TA = 4,
+        REC_LAB = 5,
+        REC_LAB_UPDATE = 6,
+        REC_SECTION = 7,
+        REC_LOG = 8,
+        REC_SEGMENT = 9,     // snapshot only: one entry of the log segment index
+        REC_LOG_PACKED = 10, // snapshot only: a column-packed block of logs
+        REC_CHECKPOINT = 100
+    };
+
+    enum SyncPolicy
+    {
+        SYNC_EVERY_RECORD, // fsync after each append
+        SYNC_BATCHED       // fsync every BATCH_SIZE records and on Commit()
+    };
+
+    struct Record
+    {
+        int type;
+        string payload;
+    };
+
+    /**
+     * @brief Result of ReadAll(): the file's version, its intact records and where they end.
+     */
+    struct Contents
+    {
+        uint32_t version = 0; // 0 if the file is missing or empty
+        vector<Record> records;
+        long end = 0; // offset just past the last intact record
+    };
+
+    static const uint32_t VERSION = 2;
+    static const uint32_t LEGACY_VERSION = 1;
+    static const size_t HEADER_SIZE = 8;
+    static const int BATCH_SIZE = 256;
+
+private:
+    string path;
+    FILE *file;
+    SyncPolicy policy;
+    int batchDepth;
+    int unsynced;
+    long size; // end of the last record that was written completely
+    mutex lock; // appends may come from several sessions at once
+
+    static void WriteHeader(ByteWriter &out)
+    {
+        out.WriteRaw("SDJL", 4);
+        out.WriteUInt32(VERSION);
+    }
+
+    static void Encode(ByteWriter &out, int type, const string &payload)
+    {
+        ByteWriter body;
+        body.WriteInt(type);
+        body.WriteRaw(payload.data(), payload.size());
+        out.WriteUInt32(static_cast<uint32_t>(body.Size()));
+        out.WriteUInt32(Crc32c::Compute(body.Data().data(), body.Size()));
+        out.WriteRaw(body.Data().data(), body.Size());
+    }
+
+    bool SyncPending()
+    {
+        if (!file || unsynced == 0)
+            return true;
+        unsynced = 0;
+        return DiskIO::Sync(file);
+    }
+
+    /**
+     * @brief Drops a partly written append: whatever stdio still buffers is
+     * flushed by fclose and then cut off again.
+     */
+    void Rollback()
+    {
+        fclose(file);
+        file = fopen(path.c_str(), "ab");
+        if (file && !DiskIO::Truncate(file, size))
+        {
+            fclose(file);
+            file = nullptr;
+        }
+        unsynced = 0;
+    }
+
+    /**
+     * @brief Writes encoded records and syncs them as the policy asks.
+     * On failure the file is cut back to where it ended before.
+     */
+    bool Write(const ByteWriter &records, int count)
+    {
+        if (!file)
+            return false;
+        bool ok = fwrite(records.Data().data(), 1, records.Size(), file) == records.Size();
+        if (ok)
+        {
+            unsynced += count;
+            if ((policy == SYNC_EVERY_RECORD && batchDepth == 0) || unsynced >= BATCH_SIZE)
+                ok = SyncPending();
+            else if (batchDepth == 0)
+                ok = fflush(file) == 0; // inside a batch the stdio buffer is flushed at EndBatch
+        }
+        if (!ok)
+        {
+            Rollback();
+            return false;
+        }
+        size += static_cast<long>(records.Size());
+        return true;
+    }
+
+public:
+    ChangeJournal(const string &p, SyncPolicy pol)
+        : path(p), file(nullptr), policy(pol), batchDepth(0), unsynced(0), size(0) {}
+    ~ChangeJournal()
+    {
+        if (file)
+        {
+            DiskIO::Sync(file);
+            fclose(file);
+        }
+    }
+
+    /**
+     * @brief Reads every intact record currently in the journal file.
+     */
+    Contents ReadAll() const
+    {
+        Contents contents;
+        MappedFile mf(path);
+        if (mf.Size() == 0)
+            return contents;
+
+        ByteReader in(mf.Data(), mf.Size());
+        contents.version = LEGACY_VERSION;
+        if (mf.Size() >= HEADER_SIZE && memcmp(mf.Data(), "SDJL", 4) == 0)
+        {
+            in.Skip(4);
+            in.ReadUInt32(contents.version);
+            contents.end = static_cast<long>(HEADER_SIZE);
+            if (contents.version > VERSION)
+                return contents;
+        }
+
+        while (true)
+        {
+            Record rec;
+            if (contents.version == LEGACY_VERSION)
+            {
+                if (!in.ReadInt(rec.type) || !in.ReadString(rec.payload))
+                    break;
+            }
+            else
+            {
+                uint32_t len, crc;
+                if (!in.ReadUInt32(len) || !in.ReadUInt32(crc) || len < 4 || in.Remaining() < len)
+                    break;
+                const char *body = in.Position();
+                if (Crc32c::Compute(body, len) != crc)
+                    break;
+                ByteReader head(body, len);
+                head.ReadInt(rec.type);
+                rec.payload.assign(body + 4, len - 4);
+                in.Skip(len);
+            }
+            contents.records.push_back(move(rec));
+            contents.end = static_cast<long>(in.Position() - mf.Data());
+        }
+        return contents;
+    }
+
+    /**
+     * @brief Opens the journal for appending (creating it if needed) after a ReadAll().
+     * Cuts off anything past the last intact record and rewrites a version 1 file.
+     */
+    bool Open(const Contents &contents)
+    {
+        lock_guard<mutex> guard(lock);
+        if (file)
+            fclose(file);
+        file = nullptr;
+        if (contents.version > VERSION)
+            return false;
+
+        if (contents.version == LEGACY_VERSION)
+        {
+            ByteWriter out;
+            WriteHeader(out);
+            for (const auto &rec : contents.records)
+                Encode(out, rec.type, rec.payload);
+            string staged = path + ".tmp";
+            if (!DiskIO::WriteDurably(staged, out.Data()) || !DiskIO::Replace(staged, path))
+                return false;
+        }
+
+        file = fopen(path.c_str(), "ab");
+        if (!file)
+            return false;
+        fseek(file, 0, SEEK_END);
+        size = ftell(file);
+        if (contents.version == VERSION && size > contents.end)
+        {
+            // The cut-off tail may be a torn write or damage; keep it for inspection either way
+            if (DiskIO::Copy(path, path + ".corrupt"))
+                cout << "Warning: " << path << ": dropped " << size - contents.end
+                     << " unreadable byte(s) at the end; a copy was kept as " << path << ".corrupt.\n";
+            if (!DiskIO::Truncate(file, contents.end))
+                return false;
+            size = contents.end;
+        }
+        if (size == 0)
+        {
+            ByteWriter header;
+            WriteHeader(header);
+            if (fwrite(header.Data().data(), 1, header.Size(), file) != header.Size() || !DiskIO::Sync(file))
+            {
+                Rollback();
+                return false;
+            }
+            size = static_cast<long>(header.Size());
+        }
+        return true;
+    }
+
+    /**
+     * @return false if the record could not be written (or synced, when the policy asks);
+     * nothing of it is left in the file then.
+     */
+    bool Append(RecordType type, const string &payload)
+    {
+        lock_guard<mutex> guard(lock);
+        ByteWriter out;
+        Encode(out, type, payload);
+        return Write(out, 1);
+    }
+
+    /**
+     * @brief Appends records of one type with a single write; on failure none of them are kept.
+     */
+    bool AppendAll(RecordType type, const vector<string> &payloads)
+    {
+        lock_guard<mutex> guard(lock);
+        ByteWriter out;
+        for (const auto &payload : payloads)
+            Encode(out, type, payload);
+        return Write(out, static_cast<int>(payloads.size()));
+    }
+
+    /**
+     * @brief Makes every appended record durable.
+     */
+    bool Commit()
+    {
+        lock_guard<mutex> guard(lock);
+        return file && SyncPending();
+    }
+
+    /**
+     * @brief Groups appends (e.g. bulk operations) under a single sync.
+     */
+    void BeginBatch() override
+    {
+        lock_guard<mutex> guard(lock);
+        batchDepth++;
+    }
+    void EndBatch() override
+    {
+        lock_guard<mutex> guard(lock);
+        if (batchDepth > 0 && --batchDepth == 0)
+            SyncPending();
+    }
+
+    /**
+     * @brief Empties the journal after its contents were folded into a snapshot.
+     * If the fresh file cannot be written the journal stays closed and appends fail.
+     */
+    void Reset()
+    {
+        lock_guard<mutex> guard(lock);
+        if (file)
+            fclose(file);
+        size = 0;
+        unsynced = 0;
+        file = fopen(path.c_str(), "wb");
+        if (!file)
+            return;
+        ByteWriter header;
+        WriteHeader(header);
+        if (fwrite(header.Data().data(), 1, header.Size(), file) != header.Size() || !DiskIO::Sync(file))
+        {
+            fclose(file);
+            file = nullptr;
+            return;
+        }
+        size = static_cast<long>(header.Size());
+    }
+
+    long GetSize()
+    {
+        lock_guard<mutex> guard(lock);
+        return size;
+    }
+
+    const string &GetPath() const { return path; }
+};
+
+/**
+ * @class LogBlockCodec
+ * @brief Column-packed encoding of work log blocks.
+ * * A packed block holds up to BLOCK_ROWS logs as a dictionary of the
+ * (lab ID, section) pairs it uses, the first day, and five columns: dictionary
+ * index, day delta from the previous row, start minute, duration and leave bit.
+ * Each column is frame-of-reference coded as [base][bit width][byte length][bits]:
+ * every value is base plus a width-bit offset, packed LSB first. Time sheets
+ * are mostly filed in date order, so a row usually needs two or three bytes
+ * where the row layout spends about forty.
+ * * Decoding unpacks a block's columns with branch-free loops and hands the rows
+ * out through one reused WorkLog, so readers stream a file block by block and
+ * only intern each dictionary entry once.
+ */
+class LogBlockCodec
+{
+public:
+    static const int BLOCK_ROWS = 4096;
+
+private:
+    static const int UNSET_MINUTE = 24 * 60; // stands in for DateAndTime::NO_TIME
+    static const int MAX_WIDTH = 56;          // a value must fit one unaligned 8-byte load
+    static const size_t PADDING = 8;          // so the last value can be loaded the same way
+
+    static uint64_t LoadLE64(const char *p)
+    {
+        uint64_t v;
+        memcpy(&v, p, 8);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        v = __builtin_bswap64(v);
+#endif
+        return v;
+    }
+
+    static void PackColumn(ByteWriter &out, const vector<int64_t> &values)
+    {
+        int64_t base = *min_element(values.begin(), values.end());
+        uint64_t range = static_cast<uint64_t>(*max_element(values.begin(), values.end()) - base);
+        int width = 0;
+        while (width < 64 && (range >> width) != 0)
+            width++;
+
+        string bits;
+        bits.reserve((values.size() * width + 7) / 8 + PADDING);
+        uint64_t acc = 0;
+        int filled = 0;
+        for (int64_t v : values)
+        {
+            acc |= static_cast<uint64_t>(v - base) << filled;
+            filled += width;
+            for (; filled >= 8; filled -= 8, acc >>= 8)
+                bits.push_back(static_cast<char>(acc));
+        }
+        if (filled > 0)
+            bits.push_back(static_cast<char>(acc));
+        bits.append(PADDING, '\0');
+
+        out.WriteUInt64(static_cast<uint64_t>(base));
+        out.WriteInt(width);
+        out.WriteInt(static_cast<int>(bits.size()));
+        out.WriteRaw(bits.data(), bits.size());
+    }
+
+    static bool UnpackColumn(ByteReader &in, size_t n, vector<int64_t> &values)
+    {
+        uint64_t base;
+        int width, len;
+        if (!in.ReadUInt64(base) || !in.ReadInt(width) || !in.ReadInt(len) || width < 0 || width > MAX_WIDTH ||
+            len < 0 || static_cast<size_t>(len) < (n * width + 7) / 8 + PADDING)
+            return false;
+        const char *bits = in.Position();
+        if (!in.Skip(static_cast<size_t>(len)))
+            return false;
+
+        uint64_t mask = width == 0 ? 0 : ~0ULL >> (64 - width);
+        values.resize(n);
+        for (size_t i = 0, pos = 0; i < n; i++, pos += width)
+            values[i] = static_cast<int64_t>(base + ((LoadLE64(bits + (pos >> 3)) >> (pos & 7)) & mask));
+        return true;
+    }
+
+public:
+    /**
+     * @class Encoder
+     * @brief Collects logs and writes them to a BlockFile::Writer as packed blocks.
+     * * Call Flush() after the last Add().
+     */
+    class Encoder
+    {
+    private:
+        BlockFile::Writer &out;
+        vector<pair<int, SymbolId>> dict;
+        unordered_map<uint64_t, int> entryOf; // (lab ID, section) -> dictionary index
+        vector<int64_t> entries, days, starts, durations, leaves;
+
+    public:
+        explicit Encoder(BlockFile::Writer &w) : out(w) {}
+
+        void Add(const WorkLog &log)
+        {
+            uint64_t key = static_cast<uint64_t>(static_cast<uint32_t>(log.GetLabId())) << 32 | log.GetSectionId();
+            auto it = entryOf.emplace(key, static_cast<int>(dict.size())).first;
+            if (it->second == static_cast<int>(dict.size()))
+                dict.emplace_back(log.GetLabId(), log.GetSectionId());
+
+            const DateAndTime &t = log.GetActualTiming();
+            int start = t.GetStartMinute() == DateAndTime::NO_TIME ? UNSET_MINUTE : t.GetStartMinute();
+            int end = t.GetEndMinute() == DateAndTime::NO_TIME ? UNSET_MINUTE : t.GetEndMinute();
+            entries.push_back(it->second);
+            days.push_back(t.GetDay());
+            starts.push_back(start);
+            durations.push_back(end - start);
+            leaves.push_back(log.GetIsLeave());
+            if (days.size() == static_cast<size_t>(BLOCK_ROWS))
+                Flush();
+        }
+
+        void Flush()
+        {
+            if (days.empty())
+                return;
+            ByteWriter body;
+            body.WriteInt(static_cast<int>(dict.size()));
+            for (const auto &e : dict)
+            {
+                body.WriteInt(e.first);
+                body.WriteString(SymbolTable::Instance().Name(e.second));
+            }
+            body.WriteInt(static_cast<int>(days[0]));
+            for (size_t i = days.size() - 1; i > 0; i--)
+                days[i] -= days[i - 1];
+            days[0] = 0;
+            for (const auto *column : {&entries, &days, &starts, &durations, &leaves})
+                PackColumn(body, *column);
+            out.AppendBlock(ChangeJournal::REC_LOG_PACKED, static_cast<int>(entries.size()), body);
+
+            dict.clear();
+            entryOf.clear();
+            for (auto *column : {&entries, &days, &starts, &durations, &leaves})
+                column->clear();
+        }
+    };
+
+    /**
+     * @brief Visits the logs of one block, packed or in the row layout.
+     * @return false if the block is malformed; rows before the fault have been visited.
+     */
+    template <typename Visit>
+    static bool DecodeBlock(int kind, const char *data, size_t size, int count, Visit visit)
+    {
+        ByteReader in(data, size);
+        WorkLog log;
+        if (kind == ChangeJournal::REC_LOG)
+        {
+            for (int i = 0; i < count; i++)
+            {
+                if (!RecordCodec::ReadLog(in, log))
+                    return false;
+                visit(log);
+            }
+            return true;
+        }
+        if (kind != ChangeJournal::REC_LOG_PACKED || count < 0)
+            return false;
+
+        int dictSize, firstDay;
+        if (!in.ReadInt(dictSize) || dictSize < 0 || dictSize > count)
+            return false;
+        vector<pair<int, SymbolId>> dict(static_cast<size_t>(dictSize));
+        string section;
+        for (auto &e : dict)
+        {
+            if (!in.ReadInt(e.first) || !in.ReadString(section))
+                return false;
+            e.second = SymbolTable::Instance().Intern(section);
+        }
+        if (!in.ReadInt(firstDay))
+            return false;
+
+        size_t n = static_cast<size_t>(count);
+        vector<int64_t> entries, deltas, starts, durations, leaves;
+        for (auto *column : {&entries, &deltas, &starts, &durations, &leaves})
+            if (!UnpackColumn(in, n, *column))
+                return false;
+
+        int64_t day = firstDay;
+        for (size_t i = 0; i < n; i++)
+        {
+            int64_t start = starts[i], end = starts[i] + durations[i];
+            day += deltas[i];
+            if (entries[i] < 0 || entries[i] >= dictSize || start < 0 || start > UNSET_MINUTE || end < 0 ||
+                end > UNSET_MINUTE || day < INT32_MIN || day > INT32_MAX)
+                return false;
+            const auto &e = dict[static_cast<size_t>(entries[i])];
+            log.SetLabId(e.first);
+            log.SetSectionId(e.second);
+            log.SetIsLeave(leaves[i] != 0);
+            log.GetActualTiming().SetPacked(static_cast<int32_t>(day),
+                                            start == UNSET_MINUTE ? DateAndTime::NO_TIME : static_cast<uint16_t>(start),
+                                            end == UNSET_MINUTE ? DateAndTime::NO_TIME : static_cast<uint16_t>(end));
+            visit(log);
+        }
+        return true;
+    }
+};
+
+/**
+ * @class LogCodecBenchmark
+ * @brief `--logbench [rows]`: size and encode/decode throughput of the log encodings.
+ * * Builds a synthetic multi-year history (60 labs, four sections each, about
+ * 200 logs a day in date order, one leave in twelve) and times encoding it in
+ * the row layout and the packed layout, then scanning and decoding each file
+ * image back, checksums included.
+ */
+class LogCodecBenchmark
+{
+private:
+    static double Seconds(chrono::steady_clock::time_point from)
+    {
+        return chrono::duration<double>(chrono::steady_clock::now() - from).count();
+    }
+
+    static size_t Decode(const string &image, long &minutes)
+    {
+        size_t rows = 0;
+        for (const auto &b : BlockFile::Scan(image.data(), image.size()).blocks)
+            LogBlockCodec::DecodeBlock(b.kind, b.data, b.size, b.count, [&](const WorkLog &log)
+                                       {
+                rows++;
+                minutes += log.GetActualTiming().GetDurationMinutes(); });
+        return rows;
+    }
+
+public:
+    static int Run(size_t count)
+    {
+        static const int STARTS[] = {8 * 60, 9 * 60 + 30, 11 * 60, 14 * 60, 15 * 60 + 30};
+        vector<WorkLog> logs(count);
+        int32_t first = DateAndTime::DaysFromCivil(2020, 1, 6);
+        uint32_t seed = 12345;
+        for (size_t i = 0; i < count; i++)
+        {
+            seed = seed * 1664525u + 1013904223u;
+            int start = STARTS[(seed >> 8) % 5];
+            logs[i].SetLabId(1 + static_cast<int>((seed >> 12) % 60));
+            logs[i].SetSectionName(string(1, static_cast<char>('A' + (seed >> 20) % 4)));
+            logs[i].SetIsLeave((seed >> 24) % 12 == 0);
+            logs[i].GetActualTiming().SetPacked(first + static_cast<int32_t>(i / 200), static_cast<uint16_t>(start),
+                                                static_cast<uint16_t>(start + ((seed >> 4) % 2 ? 90 : 180)));
+        }
+
+        auto started = chrono::steady_clock::now();
+        BlockFile::Writer rowWriter;
+        for (const auto &log : logs)
+            RecordCodec::WriteLog(rowWriter.Record(ChangeJournal::REC_LOG), log);
+        string rowImage = rowWriter.Finish();
+        double rowEncode = Seconds(started);
+
+        started = chrono::steady_clock::now();
+        BlockFile::Writer packedWriter;
+        LogBlockCodec::Encoder encoder(packedWriter);
+        for (const auto &log : logs)
+            encoder.Add(log);
+        encoder.Flush();
+        string packedImage = packedWriter.Finish();
+        double packedEncode = Seconds(started);
+
+        long rowMinutes = 0, packedMinutes = 0;
+        started = chrono::steady_clock::now();
+        size_t rowRows = Decode(rowImage, rowMinutes);
+        double rowDecode = Seconds(started);
+        started = chrono::steady_clock::now();
+        size_t packedRows = Decode(packedImage, packedMinutes);
+        double packedDecode = Seconds(started);
+
+        auto line = [count](const char *name, const string &image, double encode, double decode)
+        {
+            cout << left << setw(10) << name << setw(14) << image.size() << setw(10)
+                 << static_cast<double>(image.size()) / count << setw(16) << count / encode / 1e6 << setw(16)
+                 << count / decode / 1e6 << image.size() / decode / 1e6 << "\n";
+        };
+        cout << "Logs: " << count << "\n";
+        cout << fixed << setprecision(2);
+        cout << left << setw(10) << "Layout" << setw(14) << "Bytes" << setw(10) << "B/log" << setw(16)
+             << "Encode Mlog/s" << setw(16) << "Decode Mlog/s" << "Decode MB/s\n";
+        line("row", rowImage, rowEncode, rowDecode);
+        line("packed", packedImage, packedEncode, packedDecode);
+        cout << "Packed is " << static_cast<double>(rowImage.size()) / packedImage.size() << "x smaller.\n";
+        cout.unsetf(ios::fixed);
+        cout << setprecision(6);
+
+        if (rowRows != count || packedRows != count || rowMinutes != packedMinutes)
+        {
+            cout << "Error: decoded logs do not match.\n";
+            return 1;
+        }
+        return 0;
+    }
+};
+
+/**
+ * @class ConcurrencyStress
+ * @brief `--stress [ops]`: throughput of the Concurrent* views against thread count.
+ * * Each thread count starts from a fresh store (200 labs of four sections, 100
+ * rooms, 50 teachers) and gives every thread the same number of mixed operations:
+ * 60% schedule reads through Snapshot(), 20% venue and faculty lookups, 15%
+ * attendance appends, 3% log counts (which publish pending appends) and 2%
+ * section writes. Afterwards the stores must hold exactly the writes made.
+ */
+class ConcurrencyStress
+{
+private:
+    static const int LABS = 200;
+    static const int ROOMS = 100;
+    static const int TEACHERS = 50;
+
+    struct Tally
+    {
+        size_t logs = 0;
+        size_t sections = 0;
+        size_t misses = 0; // reads that did not find a seeded entity
+    };
+
+    static void Work(int worker, size_t ops, ConcurrentLabDetails &labs, ConcurrentVenueDetails &venues,
+                     ConcurrentFacultyDetails &faculty, ConcurrentWorkLogDetails &logs, Tally &tally)
+    {
+        const SymbolId sectionIds[] = {SymbolTable::Instance().Intern("A"), SymbolTable::Instance().Intern("B"),
+                                       SymbolTable::Instance().Intern("C"), SymbolTable::Instance().Intern("D")};
+        int32_t today = DateAndTime::Today();
+        uint32_t seed = 2654435761u * static_cast<uint32_t>(worker + 1);
+        for (size_t i = 0; i < ops; i++)
+        {
+            seed = seed * 1664525u + 1013904223u;
+            uint32_t pick = (seed >> 16) % 100;
+            int labId = 1 + static_cast<int>((seed >> 4) % LABS);
+            if (pick < 60)
+            {
+                shared_ptr<const ScheduleSnapshot> snap = labs.Snapshot();
+                const CourseLaboratory *lab = snap->FindLab(labId);
+                if (!lab || !lab->FindSection(sectionIds[seed % 4]))
+                    tally.misses++;
+            }
+            else if (pick < 80)
+            {
+                if (!venues.FindRoom(1 + static_cast<int>(seed % ROOMS)) ||
+                    !faculty.FindTeacher(1 + static_cast<int>(seed % TEACHERS)))
+                    tally.misses++;
+            }
+            else if (pick < 95)
+            {
+                WorkLog entry;
+                entry.SetLabId(labId);
+                entry.SetSectionId(sectionIds[seed % 4]);
+                entry.SetIsLeave(seed % 12 == 0);
+                entry.GetActualTiming().SetPacked(today, 9 * 60, 10 * 60 + 30);
+                logs.AddEntry(entry);
+                tally.logs++;
+            }
+            else if (pick < 98)
+                logs.GetEntryCount();
+            else
+            {
+                ClassSection sec;
+                sec.SetDetails("W" + to_string(worker) + "_" + to_string(i), faculty.FindTeacher(1 + labId % TEACHERS),
+                               nullptr, venues.FindRoom(1 + labId % ROOMS));
+                sec.GetScheduleTime().SetPacked(-(labId % 5 + 1), 8 * 60, 9 * 60);
+                labs.AddSection(labId, "CS" + to_string(labId), sec);
+                tally.sections++;
+            }
+        }
+    }
+
+    /**
+     * @return milliseconds, or a negative value if the stores lost or invented a write.
+     */
+    static double RunOnce(int threads, size_t ops)
+    {
+        InMemoryLabDetails labStore;
+        InMemoryVenueDetails venueStore;
+        InMemoryFacultyDetails facultyStore;
+        ColumnarWorkLogDetails logStore;
+
+        venueStore.AddBuilding(CampusBlock(1, "Block 1"));
+        for (int id = 1; id <= ROOMS; id++)
+            venueStore.AddRoom(LectureHall(id, "R" + to_string(id), 1, venueStore.FindBuilding(1)));
+        for (int id = 1; id <= TEACHERS; id++)
+            facultyStore.AddTeacher(UniversityTeacher(id, "Teacher " + to_string(id)));
+        for (int id = 1; id <= LABS; id++)
+            for (char name = 'A'; name <= 'D'; name++)
+            {
+                ClassSection sec;
+                sec.SetDetails(string(1, name), facultyStore.FindTeacher(1 + id % TEACHERS),
+                               venueStore.FindBuilding(1), venueStore.FindRoom(1 + id % ROOMS));
+                sec.GetScheduleTime().SetPacked(-(id % 5 + 1), static_cast<uint16_t>(8 * 60 + (name - 'A') * 60),
+                                                static_cast<uint16_t>(8 * 60 + (name - 'A') * 60 + 50));
+                labStore.AddSection(id, "CS" + to_string(id), sec);
+            }
+
+        ConcurrentLabDetails labs(&labStore);
+        ConcurrentVenueDetails venues(&venueStore);
+        ConcurrentFacultyDetails faculty(&facultyStore);
+        ConcurrentWorkLogDetails logs(&logStore);
+
+        vector<Tally> tallies(threads);
+        vector<thread> pool;
+        auto started = chrono::steady_clock::now();
+        for (int t = 0; t < threads; t++)
+            pool.emplace_back(Work, t, ops, ref(labs), ref(venues), ref(faculty), ref(logs), ref(tallies[t]));
+        for (auto &t : pool)
+            t.join();
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - started).count();
+
+        size_t expectedLogs = 0, expectedSections = static_cast<size_t>(LABS) * 4, misses = 0;
+        for (const auto &t : tallies)
+        {
+            expectedLogs += t.logs;
+            expectedSections += t.sections;
+            misses += t.misses;
+        }
+        size_t sections = 0;
+        for (const auto &lab : labs.GetAllLabs())
+            sections += lab.GetSections().size();
+        size_t published = 0;
+        for (const auto &lab : labs.Snapshot()->labs)
+            published += lab->GetSections().size();
+        if (logs.GetEntryCount() != expectedLogs || sections != expectedSections || published != expectedSections ||
+            misses != 0)
+            return -1;
+        return ms;
+    }
+
+public:
+    static int Run(size_t ops)
+    {
+        int most = max(8, static_cast<int>(thread::hardware_concurrency()));
+        cout << "Ops per thread: " << ops << " | hardware threads: " << thread::hardware_concurrency() << "\n";
+        cout << fixed << setprecision(2);
+        cout << left << setw(10) << "Threads" << setw(14) << "Total ops" << setw(12) << "ms" << setw(14)
+             << "Mops/s" << "Speedup\n";
+        double base = 0;
+        int status = 0;
+        for (int threads = 1; threads <= most; threads *= 2)
+        {
+            double ms = RunOnce(threads, ops);
+            if (ms < 0)
+            {
+                cout << "Error: the stores do not match the writes made with " << threads << " threads.\n";
+                status = 1;
+                break;
+            }
+            double rate = threads * ops / ms / 1000;
+            if (threads == 1)
+                base = rate;
+            cout << left << setw(10) << threads << setw(14) << threads * ops << setw(12) << ms << setw(14) << rate
+                 << rate / base << "x\n";
+        }
+        cout.unsetf(ios::fixed);
+        cout << setprecision(6);
+        return status;
+    }
+};
+
+// Decorators that journal each mutation before applying it to the wrapped store
+
+class JournaledLabDetails : public LabDetails
+{
+    LabDetails *inner;
+    ChangeJournal *journal;
+
+public:
+    JournaledLabDetails(LabDetails *l, ChangeJournal *j) : inner(l), journal(j) {}
+
+    bool AddLab(const CourseLaboratory &l) override
+    {
+        ByteWriter out;
+        RecordCodec::WriteLab(out, l);
+        return journal->Append(ChangeJournal::REC_LAB, out.Data()) && inner->AddLab(l);
+    }
+    bool UpdateLab(const CourseLaboratory &l) override
+    {
+        ByteWriter out;
+        RecordCodec::WriteLab(out, l);
+        return journal->Append(ChangeJournal::REC_LAB_UPDATE, out.Data()) && inner->UpdateLab(l);
+    }
+    bool AddSection(int labId, const string &courseCode, const ClassSection &s) override
+    {
+        ByteWriter out;
+        out.WriteInt(labId);
+        out.WriteString(courseCode);
+        RecordCodec::WriteSection(out, s);
+        return journal->Append(ChangeJournal::REC_SECTION, out.Data()) && inner->AddSection(labId, courseCode, s);
+    }
+    CourseLaboratory *FindLab(int id) override { return inner->FindLab(id); }
+    deque<CourseLaboratory> &GetAllLabs() override { return inner->GetAllLabs(); }
+    void AddObserver(ScheduleObserver *o) override { inner->AddObserver(o); }
+};
+
+class JournaledVenueDetails : public VenueDetails
+{
+    VenueDetails *inner;
+    ChangeJournal *journal;
+
+public:
+    JournaledVenueDetails(VenueDetails *v, ChangeJournal *j) : inner(v), journal(j) {}
+
+    bool AddBuilding(const CampusBlock &b) override
+    {
+        ByteWriter out;
+        RecordCodec::WriteBuilding(out, b);
+        return journal->Append(ChangeJournal::REC_BUILDING, out.Data()) && inner->AddBuilding(b);
+    }
+    bool AddRoom(const LectureHall &r) override
+    {
+        ByteWriter out;
+        RecordCodec::WriteRoom(out, r);
+        return journal->Append(ChangeJournal::REC_ROOM, out.Data()) && inner->AddRoom(r);
+    }
+    CampusBlock *FindBuilding(int id) override { return inner->FindBuilding(id); }
+    LectureHall *FindRoom(int id) override { return inner->FindRoom(id); }
+    deque<CampusBlock> &GetAllBuildings() override { return inner->GetAllBuildings(); }
+    deque<LectureHall> &GetAllRooms() override { return inner->GetAllRooms(); }
+};
+
+class JournaledFacultyDetails : public FacultyDetails
+{
+    FacultyDetails *inner;
+    ChangeJournal *journal;
+
+public:
+    JournaledFacultyDetails(FacultyDetails *f, ChangeJournal *j) : inner(f), journal(j) {}
+
+    bool AddTeacher(const UniversityTeacher &t) override
+    {
+        ByteWriter out;
+        RecordCodec::WritePerson(out, t.GetId(), t.GetName());
+        return journal->Append(ChangeJournal::REC_TEACHER, out.Data()) && inner->AddTeacher(t);
+    }
+    bool AddTA(const TeachingAssistant &t) override
+    {
+        ByteWriter out;
+        RecordCodec::WritePerson(out, t.GetId(), t.GetName());
+        return journal->Append(ChangeJournal::REC_TA, out.Data()) && inner->AddTA(t);
+    }
+    UniversityTeacher *FindTeacher(int id) override { return inner->FindTeacher(id); }
+    TeachingAssistant *FindTA(int id) override { return inner->FindTA(id); }
+    deque<UniversityTeacher> &GetAllTeachers() override { return inner->GetAllTeachers(); }
+    deque<TeachingAssistant> &GetAllTAs() override { return inner->GetAllTAs(); }
+};
+
+class JournaledWorkLogDetails : public WorkLogDetails
+{
+    WorkLogDetails *inner;
+    ChangeJournal *journal;
+
+public:
+    JournaledWorkLogDetails(WorkLogDetails *w, ChangeJournal *j) : inner(w), journal(j) {}
+
+    bool AddEntry(const WorkLog &entry) override
+    {
+        ByteWriter out;
+        RecordCodec::WriteLog(out, entry);
+        return journal->Append(ChangeJournal::REC_LOG, out.Data()) && inner->AddEntry(entry);
+    }
+    bool AddEntries(const vector<WorkLog> &entries) override
+    {
+        vector<string> records;
+        records.reserve(entries.size());
+        ByteWriter out;
+        for (const auto &entry : entries)
+        {
+            out.Clear();
+            RecordCodec::WriteLog(out, entry);
+            records.push_back(out.Data());
+        }
+        return journal->AppendAll(ChangeJournal::REC_LOG, records) && inner->AddEntries(entries);
+    }
+    size_t GetEntryCount() override { return inner->GetEntryCount(); }
+    void ForEachEntry(const function<void(const WorkLog &)> &visit) override { inner->ForEachEntry(visit); }
+    void ForEachEntryInRows(size_t fromRow, size_t toRow, const function<void(const WorkLog &)> &visit) override
+    {
+        inner->ForEachEntryInRows(fromRow, toRow, visit);
+    }
+    pair<size_t, size_t> RowSpanForDays(int32_t fromDay, int32_t toDay) override
+    {
+        return inner->RowSpanForDays(fromDay, toDay);
+    }
+    void ForEachForLab(int labId, int32_t fromDay, int32_t toDay, const function<void(const WorkLog &)> &visit) override
+    {
+        inner->ForEachForLab(labId, fromDay, toDay, visit);
+    }
+    void ForEachInDateRange(int32_t fromDay, int32_t toDay, const function<void(const WorkLog &)> &visit) override
+    {
+        inner->ForEachInDateRange(fromDay, toDay, visit);
+    }
+    vector<LabLogSummary> SummarizeByLab() override { return inner->SummarizeByLab(); }
+};
+
+/**
+ * @class SegmentedWorkLogDetails
+ * @brief Log store partitioned by academic term, with closed terms loaded on demand.
+ * * Terms are half-years: S1 runs January to June and S2 July to December.
+ * Entries of the current term, later terms and undated entries stay in memory
+ * and are saved to logs.dat. Each closed term is a segment: its own
+ * logs_<term>.dat file, or, once more than WARM_TERMS terms old, a slice of
+ * the cold archive logs_archive.dat. logs_index.dat records every segment's
+ * location, entry count and per-lab totals, so startup reads only the index
+ * and the current term, and SummarizeByLab and GetEntryCount never open a
+ * segment. Date and lab queries open just the segments they overlap; at most
+ * MAX_RESIDENT_SEGMENTS unmodified segments stay decoded, least recently used
+ * first out.
+ * * Rows are numbered segment by segment in term order, followed by the
+ * in-memory rows. A late entry for a closed term is added to its segment,
+ * which is written back at the next compaction.
+ */
+class SegmentedWorkLogDetails : public WorkLogDetails
+{
+public:
+    static const int WARM_TERMS = 4;
+    static const size_t MAX_RESIDENT_SEGMENTS = 4;
+    static const char *const INDEX_FILE;
+    static const char *const ARCHIVE_FILE;
+
+    static int TermOf(int32_t day)
+    {
+        int y, m, d;
+        DateAndTime::CivilFromDays(day, y, m, d);
+        return y * 2 + (m >= 7);
+    }
+    static int32_t TermStart(int term) { return DateAndTime::DaysFromCivil(term / 2, term % 2 ? 7 : 1, 1); }
+    static int32_t TermEnd(int term) { return TermStart(term + 1) - 1; }
+    static string TermLabel(int term) { return to_string(term / 2) + "-S" + to_string(term % 2 + 1); }
+    static string SegmentFile(int term) { return "logs_" + TermLabel(term) + ".dat"; }
+
+private:
+    struct Segment
+    {
+        int term = 0;
+        size_t entries = 0;
+        vector<LabLogSummary> summary; // as of the last save; recomputed while dirty
+        bool archived = false;
+        uint64_t archiveOffset = 0, archiveSize = 0;
+        shared_ptr<ColumnarWorkLogDetails> rows; // null until opened
+        bool dirty = false;                      // rows differ from what is on disk
+        uint64_t lastUse = 0;
+    };
+
+    struct Slice
+    {
+        shared_ptr<ColumnarWorkLogDetails> rows;
+        size_t firstRow;
+    };
+
+    /**
+     * @brief Archive placements computed by Stage, applied once the snapshot commits.
+     */
+    struct StagedArchive
+    {
+        map<int, pair<uint64_t, uint64_t>> placement; // term -> (offset, size)
+        vector<int> newlyArchived;
+    };
+
+    ColumnarWorkLogDetails hot;
+    map<int, Segment> segments;
+    int currentTerm;
+    uint64_t useClock;
+    StagedArchive staged;
+    mutex segmentLock;              // guards segments; readers may open them concurrently
+    atomic<bool> newerFiles{false}; // a file was written by a newer format version
+
+    /**
+     * @brief Reports damage or a newer format in a file read from 'path' (labelled 'label').
+     * A damaged file is copied to <path>.corrupt before a compaction can rewrite it.
+     */
+    void CheckImage(const string &label, const string &path, const BlockFile::Image &img)
+    {
+        if (img.version > BlockFile::VERSION)
+        {
+            newerFiles = true;
+            cout << "Warning: " << label << " uses format version " << img.version
+                 << ", newer than this program supports; it was not loaded.\n";
+        }
+        if (img.corruptBlocks > 0)
+            cout << "Warning: " << label << ": skipped " << img.corruptBlocks << " corrupted block(s) ("
+                 << img.corruptBytes << " bytes).\n";
+        if (img.truncated)
+            cout << "Warning: " << label << " is truncated; records after the cut were not loaded.\n";
+        if ((img.corruptBlocks > 0 || img.truncated) && DiskIO::Copy(path, path + ".corrupt"))
+            cout << "A copy of the damaged " << path << " was kept as " << path << ".corrupt.\n";
+    }
+
+    static void DecodeLogs(const BlockFile::Image &img, WorkLogDetails &out)
+    {
+        for (const auto &b : img.blocks)
+            LogBlockCodec::DecodeBlock(b.kind, b.data, b.size, b.count, [&out](const WorkLog &log)
+                                       { out.AddEntry(log); });
+    }
+
+    static string EncodeLogs(WorkLogDetails &rows)
+    {
+        BlockFile::Writer out;
+        LogBlockCodec::Encoder encoder(out);
+        rows.ForEachEntry([&encoder](const WorkLog &log)
+                          { encoder.Add(log); });
+        encoder.Flush();
+        return out.Finish();
+    }
+
+    void Decode(Segment &s)
+    {
+        auto rows = make_shared<ColumnarWorkLogDetails>();
+        string file = s.archived ? ARCHIVE_FILE : SegmentFile(s.term);
+        MappedFile mf(file);
+        if (s.archived && s.archiveOffset + s.archiveSize <= mf.Size())
+        {
+            BlockFile::Image img = BlockFile::Scan(mf.Data() + s.archiveOffset, static_cast<size_t>(s.archiveSize));
+            CheckImage(file + " (" + TermLabel(s.term) + ")", file, img);
+            DecodeLogs(img, *rows);
+        }
+        else if (!s.archived)
+        {
+            BlockFile::Image img = BlockFile::Scan(mf);
+            CheckImage(file, file, img);
+            DecodeLogs(img, *rows);
+        }
+        if (rows->GetEntryCount() != s.entries && !s.dirty)
+            cout << "Warning: " << file << ": " << TermLabel(s.term) << " holds " << rows->GetEntryCount()
+                 << " entries, index says " << s.entries << ".\n";
+        s.entries = rows->GetEntryCount();
+        s.rows = rows;
+    }
+
+    /**
+     * @brief Decodes a segment if needed and pins it for the caller. segmentLock must be held.
+     */
+    shared_ptr<ColumnarWorkLogDetails> Open(Segment &s)
+    {
+        s.lastUse = ++useClock;
+        if (s.rows)
+            return s.rows;
+        Decode(s);
+        shared_ptr<ColumnarWorkLogDetails> pinned = s.rows;
+        EvictIdle();
+        return pinned;
+    }
+
+    /**
+     * @brief Drops the least recently used clean segments beyond MAX_RESIDENT_SEGMENTS.
+     * Segments a reader still holds stay alive through its reference.
+     */
+    void EvictIdle()
+    {
+        vector<Segment *> idle;
+        for (auto &e : segments)
+            if (e.second.rows && !e.second.dirty)
+                idle.push_back(&e.second);
+        if (idle.size() <= MAX_RESIDENT_SEGMENTS)
+            return;
+        sort(idle.begin(), idle.end(), [](const Segment *a, const Segment *b)
+             { return a->lastUse < b->lastUse; });
+        for (size_t i = 0; i + MAX_RESIDENT_SEGMENTS < idle.size(); i++)
+            idle[i]->rows.reset();
+    }
+
+    /**
+     * @brief Segment for a closed term, created if the term has none yet. segmentLock must be held.
+     */
+    Segment &SegmentFor(int term)
+    {
+        auto it = segments.find(term);
+        if (it != segments.end())
+            return it->second;
+        Segment &s = segments[term];
+        s.term = term;
+        // A file the index does not know about (e.g. a lost index) is adopted, never overwritten
+        if (!DiskIO::Exists(SegmentFile(term)))
+            s.rows = make_shared<ColumnarWorkLogDetails>();
+        return s;
+    }
+
+    /**
+     * @brief Pins, in term order, every segment for which keep(segment, firstRow) holds.
+     */
+    vector<Slice> OpenSegments(const function<bool(const Segment &, size_t)> &keep)
+    {
+        lock_guard<mutex> guard(segmentLock);
+        vector<Slice> slices;
+        size_t firstRow = 0;
+        for (auto &e : segments)
+        {
+            if (keep(e.second, firstRow))
+                slices.push_back({Open(e.second), firstRow});
+            firstRow += e.second.entries;
+        }
+        return slices;
+    }
+
+    vector<Slice> OpenSegmentsInDays(int32_t fromDay, int32_t toDay)
+    {
+        return OpenSegments([fromDay, toDay](const Segment &s, size_t)
+                            { return TermEnd(s.term) >= fromDay && TermStart(s.term) <= toDay; });
+    }
+
+    size_t SegmentRows()
+    {
+        size_t rows = 0;
+        for (const auto &e : segments)
+            rows += e.second.entries;
+        return rows;
+    }
+
+    bool IsHot(int32_t day) const { return day < 0 || TermOf(day) >= currentTerm; }
+
+    void AddToSegment(const WorkLog &entry)
+    {
+        lock_guard<mutex> guard(segmentLock);
+        Segment &s = SegmentFor(TermOf(entry.GetActualTiming().GetDay()));
+        Open(s)->AddEntry(entry);
+        s.entries = s.rows->GetEntryCount();
+        s.dirty = true;
+    }
+
+public:
+    explicit SegmentedWorkLogDetails(int32_t today = DateAndTime::Today())
+        : currentTerm(TermOf(today)), useClock(0) {}
+
+    bool AddEntry(const WorkLog &entry) override
+    {
+        if (IsHot(entry.GetActualTiming().GetDay()))
+            return hot.AddEntry(entry);
+        AddToSegment(entry);
+        return true;
+    }
+
+    bool AddEntries(const vector<WorkLog> &entries) override
+    {
+        vector<WorkLog> current;
+        current.reserve(entries.size());
+        for (const auto &entry : entries)
+        {
+            if (IsHot(entry.GetActualTiming().GetDay()))
+                current.push_back(entry);
+            else
+                AddToSegment(entry);
+        }
+        return hot.AddEntries(current);
+    }
+
+    size_t GetEntryCount() override
+    {
+        lock_guard<mutex> guard(segmentLock);
+        return SegmentRows() + hot.GetEntryCount();
+    }
+
+    void ForEachEntry(const function<void(const WorkLog &)> &visit) override
+    {
+        for (const auto &slice : OpenSegments([](const Segment &, size_t)
+                                              { return true; }))
+            slice.rows->ForEachEntry(visit);
+        hot.ForEachEntry(visit);
+    }
+
+    void ForEachEntryInRows(size_t fromRow, size_t toRow, const function<void(const WorkLog &)> &visit) override
+    {
+        size_t hotFirst = 0;
+        vector<Slice> slices = OpenSegments([&](const Segment &s, size_t first)
+                                            {
+            hotFirst = first + s.entries;
+            return first < toRow && first + s.entries > fromRow; });
+        for (const auto &slice : slices)
+            slice.rows->ForEachEntryInRows(fromRow > slice.firstRow ? fromRow - slice.firstRow : 0,
+                                           toRow - slice.firstRow, visit);
+        if (toRow > hotFirst)
+            hot.ForEachEntryInRows(fromRow > hotFirst ? fromRow - hotFirst : 0, toRow - hotFirst, visit);
+    }
+
+    pair<size_t, size_t> RowSpanForDays(int32_t fromDay, int32_t toDay) override
+    {
+        lock_guard<mutex> guard(segmentLock);
+        size_t total = SegmentRows() + hot.GetEntryCount();
+        size_t first = total, last = 0, row = 0;
+        for (const auto &e : segments)
+        {
+            const Segment &s = e.second;
+            if (TermEnd(s.term) >= max(fromDay, 0) && TermStart(s.term) <= toDay && s.entries > 0)
+            {
+                first = min(first, row);
+                last = row + s.entries;
+            }
+            row += s.entries;
+        }
+        if (fromDay < 0 || toDay >= TermStart(currentTerm))
+        {
+            first = min(first, row);
+            last = total;
+        }
+        return first < last ? make_pair(first, last) : make_pair(size_t(0), size_t(0));
+    }
+
+    void ForEachForLab(int labId, int32_t fromDay, int32_t toDay, const function<void(const WorkLog &)> &visit) override
+    {
+        if (fromDay < 0)
+            hot.ForEachForLab(labId, fromDay, min(toDay, -1), visit);
+        // The saved per-lab totals let segments without the lab stay closed
+        vector<Slice> slices = OpenSegments([&](const Segment &s, size_t)
+                                            {
+            if (TermEnd(s.term) < max(fromDay, 0) || TermStart(s.term) > toDay)
+                return false;
+            return s.dirty || any_of(s.summary.begin(), s.summary.end(), [labId](const LabLogSummary &l)
+                                     { return l.labId == labId; }); });
+        for (const auto &slice : slices)
+            slice.rows->ForEachForLab(labId, fromDay, toDay, visit);
+        if (toDay >= 0)
+            hot.ForEachForLab(labId, max(fromDay, 0), toDay, visit);
+    }
+
+    void ForEachInDateRange(int32_t fromDay, int32_t toDay, const function<void(const WorkLog &)> &visit) override
+    {
+        // Undated in-memory rows sort first, then the closed terms, then the current ones
+        if (fromDay < 0)
+            hot.ForEachInDateRange(fromDay, min(toDay, -1), visit);
+        for (const auto &slice : OpenSegmentsInDays(max(fromDay, 0), toDay))
+            slice.rows->ForEachInDateRange(fromDay, toDay, visit);
+        if (toDay >= 0)
+            hot.ForEachInDateRange(max(fromDay, 0), toDay, visit);
+    }
+
+    vector<LabLogSummary> SummarizeByLab() override
+    {
+        map<int, LabLogSummary> merged;
+        auto add = [&merged](const vector<LabLogSummary> &part)
+        {
+            for (const auto &l : part)
+            {
+                LabLogSummary &m = merged.emplace(l.labId, LabLogSummary{l.labId, 0, 0, 0}).first->second;
+                m.entries += l.entries;
+                m.leaves += l.leaves;
+                m.presentMinutes += l.presentMinutes;
+            }
+        };
+        {
+            lock_guard<mutex> guard(segmentLock);
+            for (auto &e : segments)
+                add(e.second.dirty ? e.second.rows->SummarizeByLab() : e.second.summary);
+        }
+        add(hot.SummarizeByLab());
+
+        vector<LabLogSummary> out;
+        out.reserve(merged.size());
+        for (const auto &e : merged)
+            out.push_back(e.second);
+        return out;
+    }
+
+    /**
+     * @brief Reads logs_index.dat. Call before adding entries so they find their segments.
+     */
+    void LoadIndex()
+    {
+        MappedFile mf(INDEX_FILE);
+        BlockFile::Image img = BlockFile::Scan(mf);
+        CheckImage(INDEX_FILE, INDEX_FILE, img);
+        lock_guard<mutex> guard(segmentLock);
+        for (const auto &b : img.blocks)
+        {
+            if (b.kind != ChangeJournal::REC_SEGMENT)
+                continue;
+            ByteReader in(b.data, b.size);
+            for (int i = 0; i < b.count; i++)
+            {
+                Segment s;
+                uint64_t entries;
+                int labs;
+                if (!in.ReadInt(s.term) || !in.ReadBool(s.archived) || !in.ReadUInt64(s.archiveOffset) ||
+                    !in.ReadUInt64(s.archiveSize) || !in.ReadUInt64(entries) || !in.ReadInt(labs))
+                    break;
+                s.entries = static_cast<size_t>(entries);
+                for (int k = 0; k < labs; k++)
+                {
+                    int labId;
+                    uint64_t n, leaves, minutes;
+                    if (!in.ReadInt(labId) || !in.ReadUInt64(n) || !in.ReadUInt64(leaves) || !in.ReadUInt64(minutes))
+                        break;
+                    s.summary.push_back({labId, static_cast<size_t>(n), static_cast<size_t>(leaves), static_cast<long>(minutes)});
+                }
+                if (!in.Ok())
+                    break;
+                segments[s.term] = move(s);
+            }
+        }
+    }
+
+    /**
+     * @brief Every file a snapshot of this store may have staged, index last.
+     * * Read from the staged index if there is one, so recovery finds the
+     * segments an interrupted compaction was writing.
+     */
+    static vector<string> SnapshotFiles()
+    {
+        string indexPath = string(INDEX_FILE) + ".tmp";
+        MappedFile mf(DiskIO::Exists(indexPath) ? indexPath : string(INDEX_FILE));
+        vector<string> files;
+        for (const auto &b : BlockFile::Scan(mf).blocks)
+        {
+            if (b.kind != ChangeJournal::REC_SEGMENT)
+                continue;
+            ByteReader in(b.data, b.size);
+            for (int i = 0; i < b.count; i++)
+            {
+                int term, labs;
+                bool archived;
+                if (!in.ReadInt(term) || !in.ReadBool(archived) || !in.Skip(24) || !in.ReadInt(labs) ||
+                    labs < 0 || !in.Skip(static_cast<size_t>(labs) * 28))
+                    break;
+                if (!archived)
+                    files.push_back(SegmentFile(term));
+            }
+        }
+        files.push_back(ARCHIVE_FILE);
+        files.push_back(INDEX_FILE);
+        return files;
+    }
+
+    /**
+     * @brief The in-memory rows in the logs.dat layout.
+     */
+    string EncodeCurrent() { return EncodeLogs(hot); }
+
+    /**
+     * @brief True once any segment file has turned out to be in a newer format; compacting would lose it.
+     */
+    bool HasNewerFiles() const { return newerFiles; }
+
+    bool HasUnsavedSegments()
+    {
+        lock_guard<mutex> guard(segmentLock);
+        return any_of(segments.begin(), segments.end(), [](const pair<const int, Segment> &e)
+                      { return e.second.dirty; });
+    }
+
+    /**
+     * @brief Encodes the segment files that changed, the archive if it changed, and the index.
+     * * Segments more than WARM_TERMS terms old move into the archive. The archive
+     * is rebuilt only when a segment joins it or an archived one changed; unchanged
+     * slices are copied across without decoding. Nothing is marked saved until
+     * Committed() is called.
+     */
+    vector<pair<string, string>> Stage()
+    {
+        lock_guard<mutex> guard(segmentLock);
+        vector<pair<string, string>> files;
+        staged = StagedArchive();
+
+        bool rebuildArchive = false;
+        for (auto &e : segments)
+        {
+            Segment &s = e.second;
+            bool archive = s.archived || s.term < currentTerm - WARM_TERMS;
+            if (archive && (!s.archived || s.dirty))
+                rebuildArchive = true;
+            if (!archive && s.dirty)
+                files.emplace_back(SegmentFile(s.term), EncodeLogs(*s.rows));
+        }
+
+        if (rebuildArchive)
+        {
+            MappedFile old(ARCHIVE_FILE);
+            string archive;
+            for (auto &e : segments)
+            {
+                Segment &s = e.second;
+                if (!s.archived && s.term >= currentTerm - WARM_TERMS)
+                    continue;
+                uint64_t offset = archive.size();
+                if (s.archived && !s.dirty && s.archiveOffset + s.archiveSize <= old.Size())
+                    archive.append(old.Data() + s.archiveOffset, static_cast<size_t>(s.archiveSize));
+                else
+                    archive += EncodeLogs(*Open(s));
+                staged.placement[s.term] = {offset, archive.size() - offset};
+                if (!s.archived)
+                    staged.newlyArchived.push_back(s.term);
+            }
+            files.emplace_back(ARCHIVE_FILE, archive);
+        }
+
+        BlockFile::Writer index;
+        for (auto &e : segments)
+        {
+            Segment &s = e.second;
+            if (s.dirty)
+                s.summary = s.rows->SummarizeByLab();
+            auto placed = staged.placement.find(s.term);
+            bool archived = placed != staged.placement.end() || s.archived;
+            pair<uint64_t, uint64_t> where = placed != staged.placement.end() ? placed->second : make_pair(s.archiveOffset, s.archiveSize);
+
+            ByteWriter &out = index.Record(ChangeJournal::REC_SEGMENT);
+            out.WriteInt(s.term);
+            out.WriteBool(archived);
+            out.WriteUInt64(where.first);
+            out.WriteUInt64(where.second);
+            out.WriteUInt64(s.entries);
+            out.WriteInt(static_cast<int>(s.summary.size()));
+            for (const auto &l : s.summary)
+            {
+                out.WriteInt(l.labId);
+                out.WriteUInt64(l.entries);
+                out.WriteUInt64(l.leaves);
+                out.WriteUInt64(static_cast<uint64_t>(l.presentMinutes));
+            }
+        }
+        files.emplace_back(INDEX_FILE, index.Finish());
+        return files;
+    }
+
+    /**
+     * @brief Marks what Stage() encoded as saved once the snapshot is installed.
+     */
+    void Committed()
+    {
+        lock_guard<mutex> guard(segmentLock);
+        for (auto &e : segments)
+        {
+            Segment &s = e.second;
+            auto placed = staged.placement.find(s.term);
+            if (placed != staged.placement.end())
+            {
+                s.archived = true;
+                s.archiveOffset = placed->second.first;
+                s.archiveSize = placed->second.second;
+            }
+            s.dirty = false;
+        }
+        for (int term : staged.newlyArchived)
+            remove(SegmentFile(term).c_str());
+        staged = StagedArchive();
+        EvictIdle();
+    }
+
+    /**
+     * @brief Closed terms on disk and how many are decoded right now.
+     */
+    void GetSegmentCounts(size_t &total, size_t &resident)
+    {
+        lock_guard<mutex> guard(segmentLock);
+        total = segments.size();
+        resident = 0;
+        for (const auto &e : segments)
+            resident += e.second.rows != nullptr;
+    }
+};
+
+/**
+ * @class StorageManager
+ * @brief Owns the snapshot files and the change journal.
+ * * Startup loads the snapshot and replays the journal on top of it. Compaction
+ * writes a fresh snapshot to *.tmp files, appends a CHECKPOINT record, renames
+ * the files into place and only then empties the journal, so a crash at any
+ * point either replays the old journal or rolls the staged snapshot forward.
+ * * If any file is in a newer format than this program writes, the data is
+ * opened read-only: the journal stays closed (so every change is refused) and
+ * nothing is compacted, which would overwrite the newer file. A file with
+ * damaged blocks is copied to <file>.corrupt when it is loaded, before any
+ * compaction replaces it.
+ */
+class StorageManager
+{
+    LabDetails *labDetails;
+    VenueDetails *venueDetails;
+    FacultyDetails *facultyDetails;
+    WorkLogDetails *logDetails;
+    SegmentedWorkLogDetails *logSegments;
+    ChangeJournal *journal;
+
+    static const char *const SNAPSHOT_FILES[4];
+    enum SnapshotFile
+    {
+        FILE_VENUE,
+        FILE_FACULTY,
+        FILE_SCHEDULE,
+        FILE_LOGS
+    };
+
+    // Journal size beyond which CompactIfNeeded folds it into a new snapshot
+    static const long COMPACT_THRESHOLD = 1 << 20;
+    static const size_t MIN_LABS_PER_WORKER = 256;
+
+    /**
+     * @brief Milliseconds spent in each cold-start stage. The first three run
+     * concurrently and are measured from the start of the load.
+     */
+    struct LoadTimings
+    {
+        double venue, faculty, logs, scheduleParse, scheduleLink, journal, total;
+    } timings;
+
+    /**
+     * @brief How each snapshot file looked when it was last loaded.
+     */
+    struct FileStatus
+    {
+        uint32_t version;
+        int corruptBlocks;
+        size_t corruptBytes;
+        bool truncated;
+    } status[4];
+
+    bool readOnly; // set by Load when a file is in a newer format
+
+    string EncodeVenue()
+    {
+        BlockFile::Writer out;
+        for (auto &b : venueDetails->GetAllBuildings())
+            RecordCodec::WriteBuilding(out.Record(ChangeJournal::REC_BUILDING), b, &out);
+        for (auto &r : venueDetails->GetAllRooms())
+            RecordCodec::WriteRoom(out.Record(ChangeJournal::REC_ROOM), r, &out);
+        return out.Finish();
+    }
+
+    string EncodeFaculty()
+    {
+        BlockFile::Writer out;
+        for (auto &t : facultyDetails->GetAllTeachers())
+            RecordCodec::WritePerson(out.Record(ChangeJournal::REC_TEACHER), t.GetId(), t.GetName());
+        for (auto &t : facultyDetails->GetAllTAs())
+            RecordCodec::WritePerson(out.Record(ChangeJournal::REC_TA), t.GetId(), t.GetName());
+        return out.Finish();
+    }
+
+    string EncodeSchedule()
+    {
+        BlockFile::Writer out;
+        for (auto &lab : labDetails->GetAllLabs())
+            RecordCodec::WriteLab(out.Record(ChangeJournal::REC_LAB), lab, &out);
+        return out.Finish();
+    }
+
+    string EncodeLogs()
+    {
+        logDetails->GetEntryCount(); // folds any pending appends into the store first
+        return logSegments->EncodeCurrent();
+    }
+
+    /**
+     * @brief Records how a snapshot file was read so Load can report and upgrade it.
+     */
+    void NoteImage(int file, const BlockFile::Image &img)
+    {
+        status[file].version = img.version;
+        status[file].corruptBlocks = img.corruptBlocks;
+        status[file].corruptBytes = img.corruptBytes;
+        status[file].truncated = img.truncated;
+    }
+
+    /**
+     * @brief Calls visit(kind, reader, count, names) for each table in a snapshot file.
+     * * Block files visit every intact block, with its name table from version 4 on
+     * (nullptr before); legacy files are read as their original [count][records]
+     * tables in the order given by legacyKinds. visit returns false if a table
+     * ended early, which marks a legacy file (having no checksums) as truncated.
+     */
+    template <typename Visit>
+    void ForEachTable(int file, initializer_list<int> legacyKinds, Visit visit)
+    {
+        MappedFile mf(SNAPSHOT_FILES[file]);
+        BlockFile::Image img = BlockFile::Scan(mf);
+        NoteImage(file, img);
+        if (img.version == BlockFile::LEGACY_VERSION)
+        {
+            ByteReader in(mf.Data(), mf.Size());
+            for (int kind : legacyKinds)
+            {
+                int count = 0;
+                if (!in.ReadInt(count) || !visit(kind, in, count, nullptr))
+                {
+                    status[file].truncated = true;
+                    break;
+                }
+            }
+            return;
+        }
+        vector<SymbolId> table;
+        for (const auto &b : img.blocks)
+        {
+            ByteReader in(b.data, b.size);
+            visit(b.kind, in, b.count, BlockFile::ReadNames(b, table));
+        }
+    }
+
+    void LoadVenue()
+    {
+        ForEachTable(FILE_VENUE, {ChangeJournal::REC_BUILDING, ChangeJournal::REC_ROOM}, [this](int kind, ByteReader &in, int count, const vector<SymbolId> *names)
+                     {
+            CampusBlock b;
+            LectureHall r;
+            for (int i = 0; i < count; i++)
+            {
+                if (kind == ChangeJournal::REC_BUILDING && RecordCodec::ReadBuilding(in, b, names))
+                    venueDetails->AddBuilding(b);
+                else if (kind == ChangeJournal::REC_ROOM && RecordCodec::ReadRoom(in, venueDetails, r, names))
+                    venueDetails->AddRoom(r);
+                else
+                    return false;
+            }
+            return true; });
+    }
+
+    void LoadFaculty()
+    {
+        ForEachTable(FILE_FACULTY, {ChangeJournal::REC_TEACHER, ChangeJournal::REC_TA}, [this](int kind, ByteReader &in, int count, const vector<SymbolId> *)
+                     {
+            int id;
+            string name;
+            if (kind != ChangeJournal::REC_TEACHER && kind != ChangeJournal::REC_TA)
+                return false;
+            int i = 0;
+            for (; i < count && RecordCodec::ReadPerson(in, id, name); i++)
+            {
+                if (kind == ChangeJournal::REC_TEACHER)
+                    facultyDetails->AddTeacher(UniversityTeacher(id, name));
+                else
+                    facultyDetails->AddTA(TeachingAssistant(id, name));
+            }
+            return i == count; });
+    }
+
+    void LoadLogs()
+    {
+        ForEachTable(FILE_LOGS, {ChangeJournal::REC_LOG}, [this](int kind, ByteReader &in, int count, const vector<SymbolId> *)
+                     { return LogBlockCodec::DecodeBlock(kind, in.Position(), in.Remaining(), count, [this](const WorkLog &log)
+                                                         { logDetails->AddEntry(log); }); });
+    }
+
+    struct PendingLab
+    {
+        CourseLaboratory lab;
+        vector<RecordCodec::SectionRefs> refs;
+    };
+
+    /**
+     * @brief Decodes schedule.dat in parallel, leaving references unresolved.
+     * * Version 2 blocks are self-contained, so each one is decoded as its own
+     * task. A legacy file first gets a quick serial pass to find the record
+     * boundaries (string bodies are skipped, not copied) and is then decoded in
+     * chunks. Either way decoding stops at the first malformed record.
+     */
+    vector<PendingLab> ParseSchedule()
+    {
+        vector<PendingLab> labs;
+        MappedFile file(SNAPSHOT_FILES[FILE_SCHEDULE]);
+        BlockFile::Image img = BlockFile::Scan(file);
+        NoteImage(FILE_SCHEDULE, img);
+
+        if (BlockFile::IsBlocked(img.version))
+        {
+            vector<vector<PendingLab>> decoded(img.blocks.size());
+            ParallelFor::Run(decoded.size(), ParallelFor::ChunkCount(decoded.size(), 1), [&](size_t, size_t lo, size_t hi)
+                             {
+                for (size_t i = lo; i < hi; i++)
+                {
+                    const BlockFile::Block &b = img.blocks[i];
+                    if (b.kind != ChangeJournal::REC_LAB)
+                        continue;
+                    vector<SymbolId> table;
+                    const vector<SymbolId> *names = BlockFile::ReadNames(b, table);
+                    ByteReader in(b.data, b.size);
+                    for (int k = 0; k < b.count; k++)
+                    {
+                        PendingLab p;
+                        if (!RecordCodec::ReadLabRefs(in, p.lab, p.refs, names))
+                            break;
+                        decoded[i].push_back(move(p));
+                    }
+                } });
+            for (auto &part : decoded)
+                move(part.begin(), part.end(), back_inserter(labs));
+            return labs;
+        }
+        if (img.version != BlockFile::LEGACY_VERSION)
+            return labs;
+
+        ByteReader in(file.Data(), file.Size());
+        int count = 0;
+        in.ReadInt(count);
+        vector<const char *> bounds(1, in.Position());
+        for (int i = 0; i < count && RecordCodec::SkipLab(in); i++)
+            bounds.push_back(in.Position());
+        if (!in.Ok() || static_cast<int>(bounds.size() - 1) < count)
+            status[FILE_SCHEDULE].truncated = true;
+
+        labs.resize(bounds.size() - 1);
+        ParallelFor::Run(labs.size(), ParallelFor::ChunkCount(labs.size(), MIN_LABS_PER_WORKER), [&](size_t, size_t lo, size_t hi)
+                         {
+            for (size_t i = lo; i < hi; i++)
+            {
+                ByteReader record(bounds[i], static_cast<size_t>(bounds[i + 1] - bounds[i]));
+                RecordCodec::ReadLabRefs(record, labs[i].lab, labs[i].refs);
+            } });
+        return labs;
+    }
+
+    static double MillisSince(chrono::steady_clock::time_point from)
+    {
+        return chrono::duration<double, milli>(chrono::steady_clock::now() - from).count();
+    }
+
+    /**
+     * @brief Loads the snapshot files in dependency-aware stages.
+     * * venue.dat, faculty.dat and logs.dat are independent and load on their own
+     * threads while schedule.dat is decoded in parallel chunks. Once venue and
+     * faculty are in, section references are linked in parallel and the labs are
+     * added in file order on this thread, so schedule observers run single-threaded.
+     */
+    void LoadSnapshot()
+    {
+        auto started = chrono::steady_clock::now();
+        thread venueStage([&]
+                          { LoadVenue(); timings.venue = MillisSince(started); });
+        thread facultyStage([&]
+                            { LoadFaculty(); timings.faculty = MillisSince(started); });
+        thread logStage([&]
+                        { logSegments->LoadIndex(); LoadLogs(); timings.logs = MillisSince(started); });
+
+        vector<PendingLab> labs = ParseSchedule();
+        timings.scheduleParse = MillisSince(started);
+
+        venueStage.join();
+        facultyStage.join();
+        auto linking = chrono::steady_clock::now();
+        ParallelFor::Run(labs.size(), ParallelFor::ChunkCount(labs.size(), MIN_LABS_PER_WORKER), [&](size_t, size_t lo, size_t hi)
+                         {
+            for (size_t i = lo; i < hi; i++)
+            {
+                vector<ClassSection> &secs = labs[i].lab.GetSections();
+                for (size_t j = 0; j < secs.size(); j++)
+                    RecordCodec::ResolveSection(secs[j], labs[i].refs[j], venueDetails, facultyDetails);
+            } });
+        for (const auto &p : labs)
+            labDetails->AddLab(p.lab);
+        timings.scheduleLink = MillisSince(linking);
+
+        logStage.join();
+    }
 
-        // Check duplication
-        if (vDetails->FindBuilding(id))
+    /**
+     * @brief Applies one journal record to the plain (non-journaled) stores.
+     */
+    void ApplyRecord(const ChangeJournal::Record &rec)
+    {
+        ByteReader in(rec.payload.data(), rec.payload.size());
+        switch (rec.type)
         {
-            cout << "ID exists.\n";
-            return;
+        case ChangeJournal::REC_BUILDING:
+        {
+            CampusBlock b;
+            if (RecordCodec::ReadBuilding(in, b))
+                venueDetails->AddBuilding(b);
+            break;
+        }
+        case ChangeJournal::REC_ROOM:
+        {
+            LectureHall r;
+            if (RecordCodec::ReadRoom(in, venueDetails, r))
+                venueDetails->AddRoom(r);
+            break;
+        }
+        case ChangeJournal::REC_TEACHER:
+        case ChangeJournal::REC_TA:
+        {
+            int id;
+            string name;
+            if (!RecordCodec::ReadPerson(in, id, name))
+                break;
+            if (rec.type == ChangeJournal::REC_TEACHER)
+                facultyDetails->AddTeacher(UniversityTeacher(id, name));
+            else
+                facultyDetails->AddTA(TeachingAssistant(id, name));
+            break;
+        }
+        case ChangeJournal::REC_LAB:
+        case ChangeJournal::REC_LAB_UPDATE:
+        {
+            CourseLaboratory lab;
+            if (!RecordCodec::ReadLab(in, venueDetails, facultyDetails, lab))
+                break;
+            if (rec.type == ChangeJournal::REC_LAB)
+                labDetails->AddLab(lab);
+            else
+                labDetails->UpdateLab(lab);
+            break;
+        }
+        case ChangeJournal::REC_SECTION:
+        {
+            int labId;
+            string code;
+            ClassSection sec;
+            if (in.ReadInt(labId) && in.ReadString(code) &&
+                RecordCodec::ReadSection(in, venueDetails, facultyDetails, sec))
+                labDetails->AddSection(labId, code, sec);
+            break;
         }
+        case ChangeJournal::REC_LOG:
+        {
+            WorkLog log;
+            if (RecordCodec::ReadLog(in, log))
+                logDetails->AddEntry(log);
+            break;
+        }
+        }
+    }
 
-        // Validate Name (No empty, no digits)
-        do
+public:
+    /**
+     * @param l,v,f,w The stores or their concurrent views (not the journaled decorators).
+     * @param s The log store behind w, which also owns the closed-term segment files.
+     * @param j Journal that the decorators append to.
+     */
+    StorageManager(LabDetails *l, VenueDetails *v, FacultyDetails *f, WorkLogDetails *w, SegmentedWorkLogDetails *s,
+                   ChangeJournal *j)
+        : labDetails(l), venueDetails(v), facultyDetails(f), logDetails(w), logSegments(s), journal(j), timings(),
+          status(), readOnly(false) {}
+
+    /**
+     * @brief True if the files on disk must not be rewritten (see the class notes).
+     */
+    bool IsReadOnly() const { return readOnly || logSegments->HasNewerFiles(); }
+
+    /**
+     * @brief Folds the journal into a fresh snapshot.
+     */
+    bool Compact()
+    {
+        if (IsReadOnly())
+            return false;
+        vector<pair<string, string>> images = {{SNAPSHOT_FILES[0], EncodeVenue()},
+                                               {SNAPSHOT_FILES[1], EncodeFaculty()},
+                                               {SNAPSHOT_FILES[2], EncodeSchedule()},
+                                               {SNAPSHOT_FILES[3], EncodeLogs()}};
+        // Changed log segments, then the segment index, which is installed last
+        for (auto &image : logSegments->Stage())
+            images.push_back(move(image));
+
+        // Stage the complete snapshot before touching the live files
+        for (const auto &image : images)
         {
-            cout << "Enter Building Name: ";
-            InputOutput::SafeReadString(name);
-            if (!DataValidator::IsNonEmptyString(name))
-                cout << "Name cannot be empty.\n";
-            else if (!DataValidator::DoesNotContainDigits(name))
-                cout << "Name cannot contain numbers.\n";
-        } while (!DataValidator::IsNonEmptyString(name) || !DataValidator::DoesNotContainDigits(name));
+            if (!DiskIO::WriteDurably(image.first + ".tmp", image.second))
+                return false;
+        }
 
-        vDetails->AddBuilding(CampusBlock(id, name));
-        cout << "Building Added.\n";
+        // Commit point: from here on recovery rolls the staged snapshot forward.
+        // If it fails, recovery either drops the staged files or installs them, and both match memory.
+        if (!journal->Append(ChangeJournal::REC_CHECKPOINT, "") || !journal->Commit())
+            return false;
+
+        for (const auto &image : images)
+            DiskIO::Replace(image.first + ".tmp", image.first);
+        journal->Reset();
+        logSegments->Committed();
+        return true;
     }
 
-    void AddRoom(VenueDetails *vDetails)
+    /**
+     * @brief Compacts once the journal has grown past COMPACT_THRESHOLD.
+     * Called between menu sessions, when no role holds pointers into the stores.
+     */
+    void CompactIfNeeded()
     {
-        int id, bId;
-        string num;
-        do
-        {
-            cout << "Enter Room ID (>0): ";
-            InputOutput::SafeReadInt(id);
-            if (!DataValidator::IsValidID(id))
-                cout << "Invalid ID. Must be > 0.\n";
-        } while (!DataValidator::IsValidID(id));
+        if (journal->GetSize() > COMPACT_THRESHOLD)
+            Compact();
+    }
 
-        if (vDetails->FindRoom(id))
+    void Save()
+    {
+        if (IsReadOnly())
+            cout << "Error: data files are from a newer version of this program; nothing was saved.\n";
+        else if (Compact())
+            cout << "Data Saved Successfully.\n";
+        else
+            cout << "Error: could not write data files.\n";
+    }
+
+    void Load()
+    {
+        auto started = chrono::steady_clock::now();
+        ChangeJournal::Contents contents = journal->ReadAll();
+        vector<ChangeJournal::Record> &records = contents.records;
+        bool checkpointed = !records.empty() && records.back().type == ChangeJournal::REC_CHECKPOINT;
+        bool newerJournal = contents.version > ChangeJournal::VERSION;
+
+        vector<string> files(SNAPSHOT_FILES, SNAPSHOT_FILES + 4);
+        for (const auto &file : SegmentedWorkLogDetails::SnapshotFiles())
+            files.push_back(file);
+        // A newer journal may checkpoint staged files this program cannot read; leave them alone
+        for (const auto &file : newerJournal ? vector<string>() : files)
         {
-            cout << "ID exists.\n";
-            return;
+            string staged = file + ".tmp";
+            if (!DiskIO::Exists(staged))
+                continue;
+            // Finish an interrupted compaction, or drop a snapshot that never committed
+            if (checkpointed)
+                DiskIO::Replace(staged, file);
+            else
+                remove(staged.c_str());
         }
 
-        do
-        {
-            cout << "Enter Room Number/Name: ";
-            InputOutput::SafeReadString(num);
-            if (!DataValidator::IsNonEmptyString(num))
-                cout << "Cannot be empty.\n";
-        } while (!DataValidator::IsNonEmptyString(num));
+        LoadSnapshot();
 
-        do
+        bool legacy = false;
+        readOnly = newerJournal || logSegments->HasNewerFiles();
+        if (newerJournal)
+            cout << "Warning: " << journal->GetPath() << " uses format version " << contents.version
+                 << ", newer than this program supports; it was not replayed.\n";
+        for (int i = 0; i < 4; i++)
         {
-            cout << "Enter Building ID (>0): ";
-            InputOutput::SafeReadInt(bId);
-            if (!DataValidator::IsValidID(bId))
-                cout << "Invalid ID.\n";
-        } while (!DataValidator::IsValidID(bId));
+            const FileStatus &st = status[i];
+            if (st.version != 0 && st.version < BlockFile::VERSION)
+                legacy = true;
+            else if (st.version > BlockFile::VERSION)
+            {
+                readOnly = true;
+                cout << "Warning: " << SNAPSHOT_FILES[i] << " uses format version " << st.version
+                     << ", newer than this program supports; it was not loaded.\n";
+            }
+            if (st.corruptBlocks > 0)
+                cout << "Warning: " << SNAPSHOT_FILES[i] << ": skipped " << st.corruptBlocks
+                     << " corrupted block(s) (" << st.corruptBytes << " bytes).\n";
+            if (st.truncated)
+                cout << "Warning: " << SNAPSHOT_FILES[i] << " is truncated; records after the cut were not loaded.\n";
+            // Keep the damaged original before an upgrade or save compacts over it
+            string file = SNAPSHOT_FILES[i];
+            if ((st.corruptBlocks > 0 || st.truncated) && DiskIO::Copy(file, file + ".corrupt"))
+                cout << "A copy of the damaged " << file << " was kept as " << file << ".corrupt.\n";
+        }
 
-        CampusBlock *b = vDetails->FindBuilding(bId);
-        if (!b)
+        auto replaying = chrono::steady_clock::now();
+        if (checkpointed)
+            records.clear();
+        for (const auto &rec : records)
+            ApplyRecord(rec);
+
+        if (readOnly)
+            cout << "Warning: opened read-only; changes will be refused and nothing will be saved.\n";
+        else if (checkpointed)
+            journal->Reset();
+        else if (!journal->Open(contents))
+            cout << "Warning: could not open " << journal->GetPath() << "; changes cannot be recorded.\n";
+        timings.journal = MillisSince(replaying);
+        timings.total = MillisSince(started);
+
+        // Rewrite files in an older format straight away, and
+        // move entries of terms that have closed since the last save into segments.
+        // Loaded entries may still sit in the concurrent view's pending list; publish
+        // them first so closed-term ones have reached their segments.
+        logDetails->GetEntryCount();
+        bool rolled = logSegments->HasUnsavedSegments();
+        if ((legacy || rolled) && Compact())
         {
-            cout << "Building ID not found.\n";
-            return;
+            if (legacy)
+                cout << "Data files upgraded to format version " << BlockFile::VERSION << ".\n";
+            if (rolled)
+                cout << "Entries of closed terms moved to log segments.\n";
         }
 
-        vDetails->AddRoom(LectureHall(id, num, bId, b));
-        cout << "Room Added.\n";
+        cout << "Data Loaded.\n";
+        cout << fixed << setprecision(1) << "Load ms: venue " << timings.venue << " | faculty " << timings.faculty
+             << " | logs " << timings.logs << " | schedule parse " << timings.scheduleParse << " + link "
+             << timings.scheduleLink << " | journal " << timings.journal << " | total " << timings.total << "\n";
+        size_t segments, resident;
+        logSegments->GetSegmentCounts(segments, resident);
+        if (segments > 0)
+            cout << "Log segments: " << segments << " closed term(s) on disk, " << resident << " loaded.\n";
+        cout.unsetf(ios::fixed);
+        cout << setprecision(6);
     }
+};
 
-    void AddTeacher(FacultyDetails *fDetails)
+// ==========================================
+// SERVER MODE
+// ==========================================
+
+/**
+ * @class RequestHandler
+ * @brief Executes one request of the line-based protocol served by RoleServer.
+ * * A request is a line of whitespace-separated tokens. Every response is a
+ * status line, "OK <n> [note]" or "ERR <message>", followed by n body lines.
+ *   PING
+ *   SCHEDULE [labId]                                           schedule view
+ *   LOG <labId> <section> <date> <leave 0|1> [<start> <end>]   attendant time sheet
+ *   LABLOGS <labId>                                            HOD lab report
+ *   SUMMARY                                                    HOD lab hours summary
+ *   MAKEUP <labId> <section> <date> <start> <end>              instructor makeup request
+ *   QUIT
+ * Infrastructure and scheduling stay in the console menus. Handle() is called
+ * from several worker threads at once: reads use schedule snapshots and the
+ * concurrent log store, and the makeup queue is serialized here.
+ */
+class RequestHandler
+{
+    ConcurrentLabDetails *labs;
+    WorkLogDetails *logs; // journaled view
+    MakeupRequestQueue *queue;
+    mutex queueLock;
+
+    static bool ParseId(const string &s, int &out)
     {
-        int id;
-        string name;
-        do
-        {
-            cout << "Enter Teacher ID (>0): ";
-            InputOutput::SafeReadInt(id);
-            if (!DataValidator::IsValidID(id))
-                cout << "Invalid ID.\n";
-        } while (!DataValidator::IsValidID(id));
+        char *end = nullptr;
+        long v = strtol(s.c_str(), &end, 10);
+        if (s.empty() || *end != '\0' || v <= 0 || v > INT_MAX)
+            return false;
+        out = static_cast<int>(v);
+        return true;
+    }
 
-        if (fDetails->FindTeacher(id))
-        {
-            cout << "ID exists.\n";
-            return;
-        }
+    static string Ok(size_t lines, const string &note = "")
+    {
+        return "OK " + to_string(lines) + (note.empty() ? "" : " " + note) + "\n";
+    }
 
-        // Validate Name (No empty, no digits)
-        do
-        {
-            cout << "Enter Name: ";
-            InputOutput::SafeReadString(name);
-            if (!DataValidator::IsNonEmptyString(name))
-                cout << "Cannot be empty.\n";
-            else if (!DataValidator::DoesNotContainDigits(name))
-                cout << "Name cannot contain numbers.\n";
-        } while (!DataValidator::IsNonEmptyString(name) || !DataValidator::DoesNotContainDigits(name));
+    static string Error(const string &message) { return "ERR " + message + "\n"; }
 
-        fDetails->AddTeacher(UniversityTeacher(id, name));
-        cout << "Teacher Added.\n";
+    /**
+     * @brief Checks that a (lab, section) pair is scheduled, like the console menus do.
+     */
+    string CheckSection(const vector<string> &t, int &labId)
+    {
+        if (!ParseId(t[1], labId))
+            return "invalid lab ID";
+        shared_ptr<const ScheduleSnapshot> snap = labs->Snapshot();
+        const CourseLaboratory *lab = snap->FindLab(labId);
+        if (!lab)
+            return "lab not found";
+        if (!lab->FindSection(t[2]))
+            return "section not found";
+        if (!DataValidator::IsValidDate(t[3]))
+            return "invalid date";
+        return "";
     }
 
-    void AddTA(FacultyDetails *fDetails)
+    static string CheckTimes(const string &s, const string &e)
     {
-        int id;
-        string name;
-        do
-        {
-            cout << "Enter TA ID (>0): ";
-            InputOutput::SafeReadInt(id);
-            if (!DataValidator::IsValidID(id))
-                cout << "Invalid ID.\n";
-        } while (!DataValidator::IsValidID(id));
+        if (!DataValidator::IsValidTime(s) || !DataValidator::IsValidTime(e))
+            return "invalid time format";
+        if (!DataValidator::IsStartBeforeEnd(s, e))
+            return "start must be before end";
+        return "";
+    }
 
-        if (fDetails->FindTA(id))
+    string Schedule(const vector<string> &t)
+    {
+        int only = 0;
+        if (t.size() > 2 || (t.size() == 2 && !ParseId(t[1], only)))
+            return Error("usage: SCHEDULE [labId]");
+
+        shared_ptr<const ScheduleSnapshot> snap = labs->Snapshot();
+        string body;
+        size_t lines = 0;
+        for (const auto &lab : snap->labs)
         {
-            cout << "ID exists.\n";
-            return;
+            if (only && lab->GetLabId() != only)
+                continue;
+            for (const auto &sec : lab->GetSections())
+            {
+                const DateAndTime &time = sec.GetScheduleTime();
+                string day = time.GetDate();
+                body += to_string(lab->GetLabId()) + " " + lab->GetCourseCode() + " " + sec.GetSectionName() + " " +
+                        (day.empty() ? "-" : day) + " " + time.GetStartTime() + "-" + time.GetEndTime() + " " +
+                        (sec.GetRoom() ? sec.GetRoom()->GetRoomNumber() : "-") + " " +
+                        (sec.GetTeacher() ? sec.GetTeacher()->GetName() : "-") + "\n";
+                lines++;
+            }
         }
+        return Ok(lines) + body;
+    }
 
-        // Validate Name (No empty, no digits)
-        do
-        {
-            cout << "Enter Name: ";
-            InputOutput::SafeReadString(name);
-            if (!DataValidator::IsNonEmptyString(name))
-                cout << "Cannot be empty.\n";
-            else if (!DataValidator::DoesNotContainDigits(name))
-                cout << "Name cannot contain numbers.\n";
-        } while (!DataValidator::IsNonEmptyString(name) || !DataValidator::DoesNotContainDigits(name));
+    string Log(const vector<string> &t)
+    {
+        if (t.size() != 5 && t.size() != 7)
+            return Error("usage: LOG <labId> <section> <date> <leave 0|1> [<start> <end>]");
+        int labId;
+        string err = CheckSection(t, labId);
+        if (err.empty() && t[4] != "0" && t[4] != "1")
+            err = "leave must be 0 or 1";
+        bool leave = t[4] == "1";
+        if (err.empty() && !leave)
+            err = t.size() == 7 ? CheckTimes(t[5], t[6]) : "start and end required unless on leave";
+        if (!err.empty())
+            return Error(err);
 
-        fDetails->AddTA(TeachingAssistant(id, name));
-        cout << "TA Added.\n";
+        WorkLog entry;
+        entry.SetLabId(labId);
+        entry.SetSectionName(t[2]);
+        entry.GetActualTiming().Set(t[3], leave ? "" : t[5], leave ? "" : t[6]);
+        entry.SetIsLeave(leave);
+        if (!logs->AddEntry(entry))
+            return Error("could not record the change");
+        return Ok(0, "logged");
     }
 
-    void ViewInfrastructure(VenueDetails *v, FacultyDetails *f)
+    string LabLogs(const vector<string> &t)
     {
-        cout << "\n--- VIEW INFRASTRUCTURE ---\n";
-        cout << "1. Buildings\n2. Rooms\n3. Teachers\n4. TAs\nSelect: ";
-        int choice;
-        InputOutput::SafeReadInt(choice);
+        int labId;
+        if (t.size() != 2 || !ParseId(t[1], labId))
+            return Error("usage: LABLOGS <labId>");
+
+        string body;
+        size_t lines = 0;
+        logs->ForEachForLab(labId, INT32_MIN, INT32_MAX, [&](const WorkLog &log)
+                            {
+            const DateAndTime &time = log.GetActualTiming();
+            body += log.GetSectionName() + " " + time.GetDate() + " " + (log.GetIsLeave() ? "LEAVE" : "PRESENT");
+            if (!log.GetIsLeave())
+                body += " " + time.GetStartTime() + "-" + time.GetEndTime();
+            body += "\n";
+            lines++; });
+        return Ok(lines) + body;
+    }
 
-        if (choice == 1)
-        {
-            auto &bldgs = v->GetAllBuildings();
-            if (bldgs.empty())
-                cout << "No buildings recorded.\n";
-            else
-                for (auto &b : bldgs)
-                    cout << "ID: " << b.GetId() << " | Name: " << b.GetName() << endl;
-        }
-        else if (choice == 2)
-        {
-            auto &rooms = v->GetAllRooms();
-            if (rooms.empty())
-                cout << "No rooms recorded.\n";
-            else
-                for (auto &r : rooms)
-                    cout << "ID: " << r.GetId() << " | Room: " << r.GetRoomNumber() << " | Building ID: " << r.GetBuildingId() << endl;
-        }
-        else if (choice == 3)
-        {
-            auto &teachers = f->GetAllTeachers();
-            if (teachers.empty())
-                cout << "No teachers recorded.\n";
-            else
-                for (auto &t : teachers)
-                    cout << "ID: " << t.GetId() << " | Name: " << t.GetName() << endl;
-        }
-        else if (choice == 4)
-        {
-            auto &tas = f->GetAllTAs();
-            if (tas.empty())
-                cout << "No TAs recorded.\n";
-            else
-                for (auto &t : tas)
-                    cout << "ID: " << t.GetId() << " | Name: " << t.GetName() << endl;
-        }
+    string Summary()
+    {
+        vector<LabLogSummary> rows = logs->SummarizeByLab();
+        string body;
+        for (const auto &r : rows)
+            body += to_string(r.labId) + " " + to_string(r.entries) + " " + to_string(r.leaves) + " " +
+                    to_string(r.presentMinutes) + "\n";
+        return Ok(rows.size(), "labId entries leaves presentMinutes") + body;
     }
 
-    void ViewCompleteLabDetails(LabDetails *lDetails)
+    string Makeup(const vector<string> &t)
     {
-        cout << "\nComplete Lab Schedule\n";
-        vector<CourseLaboratory> &labs = lDetails->GetAllLabs();
-        if (labs.empty())
-        {
-            cout << "No labs scheduled.\n";
-            return;
-        }
+        if (t.size() != 6)
+            return Error("usage: MAKEUP <labId> <section> <date> <start> <end>");
+        int labId;
+        string err = CheckSection(t, labId);
+        if (err.empty())
+            err = CheckTimes(t[4], t[5]);
+        if (!err.empty())
+            return Error(err);
+
+        // CheckSection found the lab in a snapshot; the live store belongs to the main thread
+        lock_guard<mutex> guard(queueLock);
+        MakeupLabRequest request(nullptr, t[2], t[3], t[4], t[5]);
+        int id = queue->Submit(labId, request);
+        if (id < 0)
+            return Error("could not record the request");
+        return Ok(0, "request " + to_string(id));
+    }
 
-        for (const auto &lab : labs)
+public:
+    RequestHandler(ConcurrentLabDetails *l, WorkLogDetails *w, MakeupRequestQueue *q) : labs(l), logs(w), queue(q) {}
+
+    string Handle(const string &line)
+    {
+        vector<string> t;
+        size_t pos = 0;
+        while (true)
         {
-            cout << "\nLab ID: " << lab.GetLabId() << " | Code: " << lab.GetCourseCode() << "\n";
-            for (const auto &sec : lab.GetSections())
-            {
-                cout << "  Section: " << sec.GetSectionName() << "\n";
-                cout << "  Instructor: " << (sec.GetTeacher() ? sec.GetTeacher()->GetName() : "Unassigned") << "\n";
-                cout << "  Room: " << (sec.GetRoom() ? sec.GetRoom()->GetRoomNumber() : "N/A") << "\n";
-                cout << "  Time: " << sec.GetScheduleTime().GetDate() << " " << sec.GetScheduleTime().GetStartTime() << "-" << sec.GetScheduleTime().GetEndTime() << "\n";
-            }
+            pos = line.find_first_not_of(" \t", pos);
+            if (pos == string::npos)
+                break;
+            size_t end = line.find_first_of(" \t", pos);
+            t.push_back(line.substr(pos, end == string::npos ? string::npos : end - pos));
+            pos = end;
         }
+        if (t.empty())
+            return Error("empty request");
+
+        const string &cmd = t[0];
+        if (cmd == "PING")
+            return Ok(0, "PONG");
+        if (cmd == "SCHEDULE")
+            return Schedule(t);
+        if (cmd == "LOG")
+            return Log(t);
+        if (cmd == "LABLOGS")
+            return LabLogs(t);
+        if (cmd == "SUMMARY")
+            return Summary();
+        if (cmd == "MAKEUP")
+            return Makeup(t);
+        return Error("unknown command " + cmd);
     }
+};
+
+#ifndef _WIN32
+/**
+ * @class RoleServer
+ * @brief Local TCP server: one poll() loop for all sockets plus a worker pool.
+ * * The loop owns every connection, reads request lines and hands them to the
+ * workers; finished responses come back through a queue and a self-pipe wakes
+ * the loop to write them. Each connection has at most one request in flight,
+ * so responses arrive in request order even when clients pipeline.
+ */
+class RoleServer
+{
+public:
+    static const int DEFAULT_PORT = 5050;
+    static atomic<bool> stopRequested; // set by SIGINT/SIGTERM
+
+private:
+    static const int POLL_TIMEOUT_MS = 200;
+    static const size_t MAX_LINE = 64 * 1024;
 
-    void ScheduleSection(LabDetails *lDetails, VenueDetails *vDetails, FacultyDetails *fDetails)
+    struct Connection
     {
-        int labId, teacherId, bId, rId, taCount;
-        string code, secName, day, s, e;
+        int fd;
+        string in;
+        string out;
+        bool busy;
+        bool closing; // close once 'out' is flushed
+    };
+
+    struct Job
+    {
+        uint64_t conn;
+        string text; // request, then response
+    };
 
-        do
-        {
-            cout << "Lab ID: ";
-            InputOutput::SafeReadInt(labId);
-            if (!DataValidator::IsValidID(labId))
-                cout << "Invalid ID.\n";
-        } while (!DataValidator::IsValidID(labId));
-        do
-        {
-            cout << "Course Code: ";
-            InputOutput::SafeReadString(code);
-            if (!DataValidator::IsNonEmptyString(code))
-                cout << "Cannot be empty.\n";
-        } while (!DataValidator::IsNonEmptyString(code));
-        do
-        {
-            cout << "Section Name: ";
-            InputOutput::SafeReadString(secName);
-            if (!DataValidator::IsNonEmptyString(secName))
-                cout << "Cannot be empty.\n";
-        } while (!DataValidator::IsNonEmptyString(secName));
+    RequestHandler &handler;
+    int port;
+    unsigned workerCount;
+    int listenFd;
+    int wake[2];
+    map<uint64_t, Connection> conns;
+    uint64_t nextConnId;
 
-        do
-        {
-            cout << "Teacher ID: ";
-            InputOutput::SafeReadInt(teacherId);
-            if (!fDetails->FindTeacher(teacherId))
-                cout << "Teacher ID not found.\n";
-        } while (!fDetails->FindTeacher(teacherId));
+    mutex jobLock;
+    condition_variable jobReady;
+    deque<Job> jobs;
+    bool stopping;
 
-        do
-        {
-            cout << "Building ID: ";
-            InputOutput::SafeReadInt(bId);
-            if (!vDetails->FindBuilding(bId))
-                cout << "Building ID not found.\n";
-        } while (!vDetails->FindBuilding(bId));
+    mutex doneLock;
+    vector<Job> done;
+    atomic<long> served;
 
-        do
-        {
-            cout << "Room ID: ";
-            InputOutput::SafeReadInt(rId);
-            LectureHall *r = vDetails->FindRoom(rId);
-            if (!r)
-                cout << "Room ID not found.\n";
-            else if (r->GetBuildingId() != bId)
-            {
-                cout << "Room does not belong to the selected building.\n";
-                r = nullptr;
-            }
-            if (!r)
-                continue;
-            else
-                break;
-        } while (true);
+    static void OnSignal(int) { stopRequested = true; }
 
-        do
-        {
-            cout << "Day/Date (YYYY-MM-DD or Weekday): ";
-            InputOutput::SafeReadString(day);
-            if (!DataValidator::IsNonEmptyString(day))
-                cout << "Cannot be empty.\n";
-        } while (!DataValidator::IsNonEmptyString(day));
+    static void SetNonBlocking(int fd) { fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK); }
 
+    bool Listen()
+    {
+        listenFd = socket(AF_INET, SOCK_STREAM, 0);
+        if (listenFd < 0)
+            return false;
+        int one = 1;
+        setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+        sockaddr_in addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(static_cast<uint16_t>(port));
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        if (::bind(listenFd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0 || listen(listenFd, 128) != 0)
+            return false;
+        SetNonBlocking(listenFd);
+        return true;
+    }
+
+    void WorkerLoop()
+    {
         while (true)
         {
-            cout << "Start (HH:MM): ";
-            InputOutput::SafeReadString(s);
-            cout << "End (HH:MM): ";
-            InputOutput::SafeReadString(e);
-            if (!DataValidator::IsValidTime(s) || !DataValidator::IsValidTime(e))
+            Job job;
             {
-                cout << "Invalid time format. Use HH:MM.\n";
+                unique_lock<mutex> lock(jobLock);
+                jobReady.wait(lock, [this]
+                              { return stopping || !jobs.empty(); });
+                if (jobs.empty())
+                    return;
+                job = std::move(jobs.front());
+                jobs.pop_front();
             }
-            else if (!DataValidator::IsStartBeforeEnd(s, e))
+
+            job.text = handler.Handle(job.text);
+            served++;
             {
-                cout << "Start time must be strictly before End time.\n";
+                lock_guard<mutex> lock(doneLock);
+                done.push_back(std::move(job));
             }
-            else
+            char b = 1;
+            if (write(wake[1], &b, 1) < 0)
             {
-                break;
+                // Pipe full: the loop already has a wake-up pending
             }
         }
+    }
 
-        UniversityTeacher *t = fDetails->FindTeacher(teacherId);
-        CampusBlock *b = vDetails->FindBuilding(bId);
-        LectureHall *r = vDetails->FindRoom(rId);
-
-        ClassSection sec;
-        sec.SetDetails(secName, t, b, r);
-        sec.GetScheduleTime().Set(day, s, e);
-
-        cout << "Num TAs: ";
-        InputOutput::SafeReadInt(taCount);
-        for (int i = 0; i < taCount; i++)
+    void AcceptAll()
+    {
+        while (true)
         {
-            int taId;
-            cout << "TA ID: ";
-            InputOutput::SafeReadInt(taId);
-            TeachingAssistant *ta = fDetails->FindTA(taId);
-            if (ta)
-                sec.AddTA(ta);
-            else
-                cout << "TA ID " << taId << " not found, skipping.\n";
+            int fd = accept(listenFd, nullptr, nullptr);
+            if (fd < 0)
+                return;
+            SetNonBlocking(fd);
+            conns[nextConnId++] = {fd, "", "", false, false};
         }
+    }
 
-        CourseLaboratory *lab = lDetails->FindLab(labId);
-        if (lab)
+    /**
+     * @return false if the peer closed the connection or sent an oversized line.
+     */
+    bool ReadFrom(Connection &c)
+    {
+        char buf[4096];
+        while (true)
         {
-            lab->AddSection(sec);
-            lDetails->UpdateLab(*lab);
+            ssize_t n = recv(c.fd, buf, sizeof(buf), 0);
+            if (n > 0)
+            {
+                c.in.append(buf, static_cast<size_t>(n));
+                if (c.in.size() > MAX_LINE && c.in.find('\n') == string::npos)
+                    return false;
+                continue;
+            }
+            return n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK);
         }
-        else
+    }
+
+    bool WriteTo(Connection &c)
+    {
+        while (!c.out.empty())
         {
-            CourseLaboratory newLab;
-            newLab.SetLabId(labId);
-            newLab.SetCourseCode(code);
-            newLab.AddSection(sec);
-            lDetails->AddLab(newLab);
+            ssize_t n = send(c.fd, c.out.data(), c.out.size(), MSG_NOSIGNAL);
+            if (n < 0)
+                return errno == EAGAIN || errno == EWOULDBLOCK;
+            c.out.erase(0, static_cast<size_t>(n));
         }
-        cout << "Scheduled.\n";
+        return !c.closing;
     }
 
-    void ViewMakeupRequests(LabDetails *lDetails)
+    void Dispatch(uint64_t id, Connection &c)
     {
-        vector<MakeupLabRequest> requests = ReadMakeupRequestsFromBinary(lDetails);
-        if (requests.empty())
+        size_t nl;
+        if (c.busy || c.closing || (nl = c.in.find('\n')) == string::npos)
+            return;
+        string line = c.in.substr(0, nl);
+        c.in.erase(0, nl + 1);
+        if (!line.empty() && line.back() == '\r')
+            line.pop_back();
+
+        if (line == "QUIT")
         {
-            cout << "\nNo makeup requests.\n";
+            c.out += "OK 0 bye\n";
+            c.closing = true;
             return;
         }
-
-        cout << "\nMakeup Requests\n";
-        for (const auto &req : requests)
+        c.busy = true;
         {
-            int labId = (req.GetLab() ? req.GetLab()->GetLabId() : -1);
-            cout << "Lab: " << labId << " | Sec: " << req.GetSectionName() << " | Date: " << req.GetRequestedDate() << "\n";
+            lock_guard<mutex> lock(jobLock);
+            jobs.push_back({id, line});
         }
+        jobReady.notify_one();
     }
 
-    void ScheduleMakeupLab(LabDetails *lDetails, VenueDetails *vDetails, FacultyDetails *fDetails)
+    void CollectResponses()
     {
-        vector<MakeupLabRequest> requests = ReadMakeupRequestsFromBinary(lDetails);
-        if (requests.empty())
+        char buf[256];
+        while (read(wake[0], buf, sizeof(buf)) > 0)
         {
-            cout << "\nNo makeup requests.\n";
-            return;
         }
 
-        cout << "\nAvailable Makeup Requests\n";
-        for (size_t i = 0; i < requests.size(); i++)
+        vector<Job> finished;
         {
-            int labId = (requests[i].GetLab() ? requests[i].GetLab()->GetLabId() : -1);
-            cout << (i + 1) << ". Lab ID: " << labId << ", Sec: " << requests[i].GetSectionName() << endl;
+            lock_guard<mutex> lock(doneLock);
+            finished.swap(done);
         }
+        for (auto &job : finished)
+        {
+            auto it = conns.find(job.conn);
+            if (it == conns.end())
+                continue; // client went away while its request ran
+            it->second.out += job.text;
+            it->second.busy = false;
+        }
+    }
 
-        int choice;
-        cout << "\nSelect request number (0 to cancel): ";
-        InputOutput::SafeReadInt(choice);
-        if (choice < 1 || choice > (int)requests.size())
-            return;
-
-        MakeupLabRequest selected = requests[choice - 1];
-
-        int teacherId, bId, rId, taCount;
+    void Close(map<uint64_t, Connection>::iterator it)
+    {
+        close(it->second.fd);
+        conns.erase(it);
+    }
 
-        do
+    void PollOnce()
+    {
+        vector<pollfd> fds;
+        vector<uint64_t> ids;
+        fds.push_back({listenFd, POLLIN, 0});
+        fds.push_back({wake[0], POLLIN, 0});
+        for (const auto &c : conns)
         {
-            cout << "Instructor ID: ";
-            InputOutput::SafeReadInt(teacherId);
-            if (!fDetails->FindTeacher(teacherId))
-                cout << "Teacher not found.\n";
-        } while (!fDetails->FindTeacher(teacherId));
+            short events = static_cast<short>(POLLIN | (c.second.out.empty() ? 0 : POLLOUT));
+            fds.push_back({c.second.fd, events, 0});
+            ids.push_back(c.first);
+        }
+        if (poll(fds.data(), fds.size(), POLL_TIMEOUT_MS) <= 0)
+            return;
 
-        do
-        {
-            cout << "Building ID: ";
-            InputOutput::SafeReadInt(bId);
-            if (!vDetails->FindBuilding(bId))
-                cout << "Building not found.\n";
-        } while (!vDetails->FindBuilding(bId));
+        if (fds[0].revents & POLLIN)
+            AcceptAll();
+        if (fds[1].revents & POLLIN)
+            CollectResponses();
 
-        do
+        for (size_t i = 2; i < fds.size(); i++)
         {
-            cout << "Room ID: ";
-            InputOutput::SafeReadInt(rId);
-            LectureHall *r = vDetails->FindRoom(rId);
-            if (!r)
-                cout << "Room not found.\n";
-            else if (r->GetBuildingId() != bId)
+            auto it = conns.find(ids[i - 2]);
+            if (it == conns.end())
+                continue;
+            Connection &c = it->second;
+            if ((fds[i].revents & (POLLIN | POLLHUP | POLLERR)) && !ReadFrom(c))
             {
-                cout << "Room not in building.\n";
-                r = nullptr;
+                Close(it);
+                continue;
             }
-            if (r)
-                break;
-        } while (true);
-
-        UniversityTeacher *t = fDetails->FindTeacher(teacherId);
-        CampusBlock *b = vDetails->FindBuilding(bId);
-        LectureHall *r = vDetails->FindRoom(rId);
-
-        ClassSection makeupSec;
-        makeupSec.SetDetails(selected.GetSectionName() + "_MAKEUP", t, b, r);
-        makeupSec.GetScheduleTime().Set(selected.GetRequestedDate(), selected.GetRequestedStartTime(), selected.GetRequestedEndTime());
+            Dispatch(it->first, c);
+            if (!WriteTo(c))
+                Close(it);
+        }
 
-        cout << "Num TAs: ";
-        InputOutput::SafeReadInt(taCount);
-        for (int i = 0; i < taCount; i++)
+        // Responses collected above may belong to connections that had no socket event
+        for (auto it = conns.begin(); it != conns.end();)
         {
-            int taId;
-            cout << "TA ID: ";
-            InputOutput::SafeReadInt(taId);
-            TeachingAssistant *ta = fDetails->FindTA(taId);
-            if (ta)
-                makeupSec.AddTA(ta);
+            auto current = it++;
+            Dispatch(current->first, current->second);
+            if (!current->second.out.empty() && !WriteTo(current->second))
+                Close(current);
         }
+    }
 
-        selected.GetLab()->AddSection(makeupSec);
-        lDetails->UpdateLab(*selected.GetLab());
-
-        requests.erase(requests.begin() + (choice - 1));
-        WriteMakeupRequestsToBinary(requests);
-        cout << "Makeup Scheduled.\n";
+public:
+    RoleServer(RequestHandler &h, int p, unsigned workers)
+        : handler(h), port(p), workerCount(max(1u, workers)), listenFd(-1), nextConnId(1), stopping(false), served(0)
+    {
+        wake[0] = wake[1] = -1;
     }
 
-    void ShowMenu(LabDetails *l, VenueDetails *v, FacultyDetails *f)
+    int Run()
     {
-        while (true)
+        if (!Listen() || pipe(wake) != 0)
         {
-            cout << "\n--- ACADEMIC OFFICER DASHBOARD ---\n";
-            cout << "1. Add Infrastructure (Building/Room/Faculty)\n";
-            cout << "2. Schedule Section\n";
-            cout << "3. View Complete Lab Schedule\n";
-            cout << "4. View Existing Infrastructure\n";
-            cout << "5. View Makeup Requests\n";
-            cout << "6. Schedule Makeup Lab\n";
-            cout << "7. Logout\n";
-            cout << "Select: ";
+            perror("server");
+            return 1;
+        }
+        SetNonBlocking(wake[0]);
+        SetNonBlocking(wake[1]);
+        signal(SIGINT, OnSignal);
+        signal(SIGTERM, OnSignal);
+        signal(SIGPIPE, SIG_IGN);
 
-            int ch;
-            InputOutput::SafeReadInt(ch);
+        vector<thread> pool;
+        for (unsigned i = 0; i < workerCount; i++)
+            pool.emplace_back(&RoleServer::WorkerLoop, this);
 
-            if (ch == 1)
-            {
-                cout << "\n--- ADD INFRASTRUCTURE ---\n";
-                cout << "1. Add Building\n";
-                cout << "2. Add Room\n";
-                cout << "3. Add Teacher\n";
-                cout << "4. Add Teaching Assistant\n";
-                cout << "0. Back\n";
-                cout << "Select: ";
+        cout << "Serving on 127.0.0.1:" << port << " with " << workerCount << " workers (Ctrl+C to stop).\n";
+        auto started = chrono::steady_clock::now();
+        while (!stopRequested)
+            PollOnce();
 
-                int sub;
-                InputOutput::SafeReadInt(sub);
-                if (sub == 1)
-                    AddBuilding(v);
-                else if (sub == 2)
-                    AddRoom(v);
-                else if (sub == 3)
-                    AddTeacher(f);
-                else if (sub == 4)
-                    AddTA(f);
-            }
-            else if (ch == 2)
-                ScheduleSection(l, v, f);
-            else if (ch == 3)
-                ViewCompleteLabDetails(l);
-            else if (ch == 4)
-                ViewInfrastructure(v, f);
-            else if (ch == 5)
-                ViewMakeupRequests(l);
-            else if (ch == 6)
-                ScheduleMakeupLab(l, v, f);
-            else
-                return;
+        {
+            lock_guard<mutex> lock(jobLock);
+            stopping = true;
         }
+        jobReady.notify_all();
+        for (auto &t : pool)
+            t.join();
+        while (!conns.empty())
+            Close(conns.begin());
+        close(listenFd);
+        close(wake[0]);
+        close(wake[1]);
+
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - started).count();
+        cout << "\nServed " << served << " requests in " << fixed << setprecision(1) << seconds << " s.\n";
+        cout.unsetf(ios::fixed);
+        cout << setprecision(6);
+        return 0;
     }
 };
 
-class Instructor : public Person
+atomic<bool> RoleServer::stopRequested(false);
+
+/**
+ * @class LoadGenerator
+ * @brief Client for measuring the server: many concurrent attendants filing time sheets.
+ * * Each client thread keeps one connection and sends requests back to back:
+ * nine LOG requests for every SUMMARY. Latency is measured per request.
+ * LOG requests are real writes, so run it against a scratch copy of the data.
+ */
+class LoadGenerator
 {
-private:
-    void SaveMakeupRequestToBinary(const MakeupLabRequest &request)
-    {
-        ofstream out("makeup_requests.dat", ios::binary | ios::app);
-        if (out.is_open())
-        {
-            int labId = (request.GetLab() ? request.GetLab()->GetLabId() : -1);
-            out.write(reinterpret_cast<const char *>(&labId), sizeof(int));
-            string secName = request.GetSectionName();
-            int secLen = secName.length();
-            out.write(reinterpret_cast<const char *>(&secLen), sizeof(int));
-            out.write(secName.c_str(), secLen);
-            string date = request.GetRequestedDate();
-            int dateLen = date.length();
-            out.write(reinterpret_cast<const char *>(&dateLen), sizeof(int));
-            out.write(date.c_str(), dateLen);
-            string start = request.GetRequestedStartTime();
-            int startLen = start.length();
-            out.write(reinterpret_cast<const char *>(&startLen), sizeof(int));
-            out.write(start.c_str(), startLen);
-            string end = request.GetRequestedEndTime();
-            int endLen = end.length();
-            out.write(reinterpret_cast<const char *>(&endLen), sizeof(int));
-            out.write(end.c_str(), endLen);
-            out.close();
-        }
-    }
-
-    void RequestMakeupLab(LabDetails *lDetails, int labId, const string &secName, const string &date, const string &s, const string &e)
+    static int Connect(int port)
     {
-        MakeupLabRequest request(lDetails->FindLab(labId), secName, date, s, e);
-        SaveMakeupRequestToBinary(request);
-        cout << "Request Submitted.\n";
+        int fd = socket(AF_INET, SOCK_STREAM, 0);
+        if (fd < 0)
+            return -1;
+        sockaddr_in addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(static_cast<uint16_t>(port));
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        if (connect(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0)
+        {
+            close(fd);
+            return -1;
+        }
+        return fd;
     }
 
-public:
-    Instructor() : Person("Instructor") {}
-    void ShowMenu(LabDetails *lDetails)
+    static bool ReadLine(int fd, string &buffer, string &line)
     {
-        int choice;
-        while (true)
+        size_t nl;
+        while ((nl = buffer.find('\n')) == string::npos)
         {
-            cout << "\n--- INSTRUCTOR ---\n1. Request Makeup\n2. Logout\nSelect: ";
-            InputOutput::SafeReadInt(choice);
-            if (choice == 1)
-            {
-                int id;
-                string sec, date, s, e;
-                CourseLaboratory *l = nullptr;
-                ClassSection *section = nullptr;
+            char buf[4096];
+            ssize_t n = recv(fd, buf, sizeof(buf), 0);
+            if (n <= 0)
+                return false;
+            buffer.append(buf, static_cast<size_t>(n));
+        }
+        line = buffer.substr(0, nl);
+        buffer.erase(0, nl + 1);
+        return true;
+    }
 
-                // Ensure we only makeup scheduled labs
-                do
-                {
-                    cout << "Lab ID: ";
-                    InputOutput::SafeReadInt(id);
-                    l = lDetails->FindLab(id);
-                    if (!l)
-                        cout << "Error: Lab ID not found. Can only request makeup for scheduled labs.\n";
-                } while (!l);
+    /**
+     * @brief Sends one request and reads its complete response (status plus body lines).
+     */
+    static bool Call(int fd, const string &request, string &buffer, vector<string> &response)
+    {
+        string wire = request + "\n";
+        if (send(fd, wire.data(), wire.size(), MSG_NOSIGNAL) != static_cast<ssize_t>(wire.size()))
+            return false;
 
-                do
-                {
-                    cout << "Section: ";
-                    InputOutput::SafeReadString(sec);
-                    section = l->FindSection(sec);
-                    if (!section)
-                        cout << "Error: Section not found in this Lab.\n";
-                } while (!section);
+        response.assign(1, "");
+        if (!ReadLine(fd, buffer, response[0]))
+            return false;
+        size_t lines = response[0].compare(0, 3, "OK ") == 0 ? strtoul(response[0].c_str() + 3, nullptr, 10) : 0;
+        for (size_t i = 0; i < lines; i++)
+        {
+            response.emplace_back();
+            if (!ReadLine(fd, buffer, response.back()))
+                return false;
+        }
+        return true;
+    }
 
-                do
+public:
+    static int Run(int port, int clients, int requests)
+    {
+        // Log against the first scheduled section the server knows about
+        string target;
+        int probe = Connect(port);
+        if (probe < 0)
+        {
+            cout << "Cannot connect to 127.0.0.1:" << port << ".\n";
+            return 1;
+        }
+        string buffer;
+        vector<string> response;
+        if (Call(probe, "SCHEDULE", buffer, response) && response.size() > 1)
+        {
+            size_t a = response[1].find(' ');
+            size_t b = response[1].find(' ', a + 1);
+            size_t c = response[1].find(' ', b + 1);
+            target = response[1].substr(0, a) + " " + response[1].substr(b + 1, c - b - 1);
+        }
+        close(probe);
+        if (target.empty())
+            cout << "No scheduled sections; sending SUMMARY requests only.\n";
+
+        vector<vector<double>> latencies(static_cast<size_t>(clients));
+        atomic<long> errors(0);
+        auto started = chrono::steady_clock::now();
+        vector<thread> pool;
+        for (int c = 0; c < clients; c++)
+        {
+            pool.emplace_back([&, c]
+                              {
+                int fd = Connect(port);
+                if (fd < 0)
                 {
-                    cout << "Date (YYYY-MM-DD): ";
-                    InputOutput::SafeReadString(date);
-                    if (!DataValidator::IsValidDate(date))
-                        cout << "Invalid Date Format or Value (Use YYYY-MM-DD).\n";
-                } while (!DataValidator::IsValidDate(date));
-
-                while (true)
+                    errors += requests;
+                    return;
+                }
+                string buf;
+                vector<string> resp;
+                vector<double> &mine = latencies[static_cast<size_t>(c)];
+                mine.reserve(static_cast<size_t>(requests));
+                for (int i = 0; i < requests; i++)
                 {
-                    cout << "Start (HH:MM): ";
-                    InputOutput::SafeReadString(s);
-                    cout << "End (HH:MM): ";
-                    InputOutput::SafeReadString(e);
-                    if (!DataValidator::IsValidTime(s) || !DataValidator::IsValidTime(e))
-                        cout << "Invalid time format.\n";
-                    else if (!DataValidator::IsStartBeforeEnd(s, e))
-                        cout << "Start time must be strictly before End time.\n";
-                    else
+                    char date[16];
+                    snprintf(date, sizeof(date), "2024-01-%02d", 1 + (c + i) % 28);
+                    string req = (target.empty() || i % 10 == 9) ? "SUMMARY" : "LOG " + target + " " + date + " 0 09:00 10:00";
+                    auto t0 = chrono::steady_clock::now();
+                    if (!Call(fd, req, buf, resp))
+                    {
+                        errors += requests - i;
                         break;
+                    }
+                    mine.push_back(chrono::duration<double, micro>(chrono::steady_clock::now() - t0).count());
+                    if (resp[0].compare(0, 3, "ERR") == 0)
+                        errors++;
                 }
-
-                RequestMakeupLab(lDetails, id, sec, date, s, e);
-            }
-            else
-                return;
+                close(fd); });
+        }
+        for (auto &t : pool)
+            t.join();
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - started).count();
+
+        vector<double> all;
+        for (const auto &l : latencies)
+            all.insert(all.end(), l.begin(), l.end());
+        if (all.empty())
+        {
+            cout << "No requests completed.\n";
+            return 1;
         }
+        sort(all.begin(), all.end());
+        double p50 = all[all.size() / 2];
+        double p99 = all[min(all.size() - 1, all.size() * 99 / 100)];
+
+        cout << fixed << setprecision(1);
+        cout << all.size() << " requests from " << clients << " clients in " << seconds << " s: "
+             << all.size() / seconds << " req/s | p50 " << p50 << " us | p99 " << p99 << " us | max "
+             << all.back() << " us | errors " << errors << "\n";
+        cout.unsetf(ios::fixed);
+        cout << setprecision(6);
+        return errors > 0 ? 1 : 0;
     }
 };
 
-class Attendant : public Person
+/**
+ * @class StoreBenchmark
+ * @brief `--bench <name> [n]`: timings of the stores and their files on synthetic data.
+ * * Every run works in a scratch directory (bench.tmp) that is removed again
+ * afterwards, so the real data files are never touched.
+ *   load [sections]   cold StorageManager::Load of n, 2n, 4n and 8n sections with
+ *                     proportional rooms, teachers and TAs; the time per section
+ *                     stays flat while references resolve through the ID indices.
+ *   startup [logs]    reads a row-layout logs file the way the old loader did
+ *                     (ifstream::read per field, a heap buffer per string) and
+ *                     through MappedFile, then times a cold StorageManager::Load
+ *                     of the same logs from the current snapshot.
+ *   aggregate [logs]  per-lab entry, leave and minute totals over n logs, from the
+ *                     columnar store and from an array of row objects as the
+ *                     store kept them before (section name held as a string).
+ */
+class StoreBenchmark
 {
 private:
-    bool IsLabSectionScheduled(LabDetails *lDetails, int labId, const string &secName)
-    {
-        CourseLaboratory *lab = lDetails->FindLab(labId);
-        if (!lab)
-            return false;
-        ClassSection *sec = lab->FindSection(secName);
-        return sec != nullptr;
-    }
+    static const char *const SCRATCH_DIR;
+    static const int REPEATS = 3; // the best of these runs is reported
 
-    void ViewScheduledLabs(LabDetails *lDetails)
+    /**
+     * @brief Enters a fresh scratch directory; leaves and deletes it when destroyed.
+     */
+    class Scratch
     {
-        cout << "\n--- SCHEDULED LABS ---\n";
-        vector<CourseLaboratory> &labs = lDetails->GetAllLabs();
-        if (labs.empty())
+        bool entered;
+
+        static void RemoveFiles()
         {
-            cout << "No labs scheduled.\n";
-            return;
+            DIR *dir = opendir(".");
+            if (!dir)
+                return;
+            while (dirent *e = readdir(dir))
+                if (strcmp(e->d_name, ".") != 0 && strcmp(e->d_name, "..") != 0)
+                    unlink(e->d_name);
+            closedir(dir);
         }
 
-        for (const auto &lab : labs)
+    public:
+        Scratch() : entered(false)
         {
-            cout << "\nCourse: " << lab.GetCourseCode() << " (ID: " << lab.GetLabId() << ")\n";
-            for (const auto &sec : lab.GetSections())
-            {
-                cout << "  Sec: " << sec.GetSectionName() << " | Time: " << sec.GetScheduleTime().GetDate() << " " << sec.GetScheduleTime().GetStartTime() << "-" << sec.GetScheduleTime().GetEndTime() << "\n";
-            }
+            mkdir(SCRATCH_DIR, 0755);
+            entered = chdir(SCRATCH_DIR) == 0;
+            if (entered)
+                RemoveFiles();
         }
-    }
+        ~Scratch()
+        {
+            if (!entered)
+                return;
+            RemoveFiles();
+            if (chdir("..") == 0)
+                rmdir(SCRATCH_DIR);
+        }
+        bool Entered() const { return entered; }
+    };
 
-    void FillTimeSheet(LabDetails *lDetails, WorkLogDetails *logDetails, int labId, const string &secName, const string &d, const string &s, const string &e, bool leave)
+    static double Millis(chrono::steady_clock::time_point from)
     {
-        WorkLog entry;
-        entry.SetLabId(labId);
-        entry.SetSectionName(secName);
-        entry.GetActualTiming().Set(d, s, e);
-        entry.SetIsLeave(leave);
-        logDetails->AddEntry(entry);
-        cout << "Time Sheet Filled.\n";
+        return chrono::duration<double, milli>(chrono::steady_clock::now() - from).count();
     }
 
-public:
-    Attendant() : Person("Attendant") {}
-    void ShowMenu(LabDetails *lDetails, WorkLogDetails *logDetails)
+    /**
+     * @brief Adds 'sections' weekly sections in labs of four, with a room for every
+     * ten sections (twenty rooms to a building) and a teacher and a TA for every five.
+     */
+    static void Populate(size_t sections, LabDetails &labs, VenueDetails &venues, FacultyDetails &faculty)
     {
-        int choice;
-        while (true)
+        int rooms = static_cast<int>(sections / 10) + 1;
+        int staff = static_cast<int>(sections / 5) + 1;
+        int buildings = rooms / 20 + 1;
+        for (int id = 1; id <= buildings; id++)
+            venues.AddBuilding(CampusBlock(id, "Block " + to_string(id)));
+        for (int id = 1; id <= rooms; id++)
         {
-            cout << "\n--- ATTENDANT ---\n1. View Labs\n2. Fill Time Sheet\n3. Logout\nSelect: ";
-            InputOutput::SafeReadInt(choice);
-            if (choice == 1)
-                ViewScheduledLabs(lDetails);
-            else if (choice == 2)
-            {
-                int id, leave;
-                string sec, d, s, e;
-                CourseLaboratory *l = nullptr;
-                ClassSection *section = nullptr;
+            int building = (id - 1) % buildings + 1;
+            venues.AddRoom(LectureHall(id, "R" + to_string(id), building, venues.FindBuilding(building)));
+        }
+        for (int id = 1; id <= staff; id++)
+        {
+            faculty.AddTeacher(UniversityTeacher(id, "Teacher " + to_string(id)));
+            faculty.AddTA(TeachingAssistant(id, "Assistant " + to_string(id)));
+        }
 
-                // Ensure filling time sheet only for scheduled labs
-                do
-                {
-                    cout << "Lab ID: ";
-                    InputOutput::SafeReadInt(id);
-                    l = lDetails->FindLab(id);
-                    if (!l)
-                        cout << "Error: Lab ID not found.\n";
-                } while (!l);
+        for (size_t i = 0; i < sections; i++)
+        {
+            int n = static_cast<int>(i);
+            LectureHall *room = venues.FindRoom((n * 7) % rooms + 1);
+            ClassSection sec;
+            sec.SetDetails(string(1, static_cast<char>('A' + n % 4)), faculty.FindTeacher(n % staff + 1),
+                           venues.FindBuilding(room->GetBuildingId()), room);
+            uint16_t start = static_cast<uint16_t>(8 * 60 + (n / 5 % 8) * 60);
+            sec.GetScheduleTime().SetPacked(-(n % 5 + 1), start, static_cast<uint16_t>(start + 50));
+            sec.AddTA(faculty.FindTA((n * 3) % staff + 1));
+            labs.AddSection(n / 4 + 1, "CS" + to_string(n / 4 + 1), sec);
+        }
+    }
 
-                do
-                {
-                    cout << "Section: ";
-                    InputOutput::SafeReadString(sec);
-                    section = l->FindSection(sec);
-                    if (!section)
-                        cout << "Error: Section not found.\n";
-                } while (!section);
+    /**
+     * @brief 'count' logs of the current term in date order: 60 labs of four sections,
+     * one leave in twelve.
+     */
+    static vector<WorkLog> TermLogs(size_t count)
+    {
+        static const int STARTS[] = {8 * 60, 9 * 60 + 30, 11 * 60, 14 * 60, 15 * 60 + 30};
+        int32_t today = DateAndTime::Today();
+        int y, m, d;
+        DateAndTime::CivilFromDays(today, y, m, d);
+        int32_t first = DateAndTime::DaysFromCivil(y, m >= 7 ? 7 : 1, 1);
+
+        vector<WorkLog> logs(count);
+        uint32_t seed = 12345;
+        for (size_t i = 0; i < count; i++)
+        {
+            seed = seed * 1664525u + 1013904223u;
+            int start = STARTS[(seed >> 8) % 5];
+            logs[i].SetLabId(1 + static_cast<int>((seed >> 12) % 60));
+            logs[i].SetSectionName(string(1, static_cast<char>('A' + (seed >> 20) % 4)));
+            logs[i].SetIsLeave((seed >> 24) % 12 == 0);
+            logs[i].GetActualTiming().SetPacked(first + static_cast<int32_t>(i * (today - first + 1) / count),
+                                                static_cast<uint16_t>(start), static_cast<uint16_t>(start + 90));
+        }
+        return logs;
+    }
 
-                do
-                {
-                    cout << "Date (YYYY-MM-DD): ";
-                    InputOutput::SafeReadString(d);
-                    if (!DataValidator::IsValidDate(d))
-                        cout << "Invalid Date Format or Value.\n";
-                } while (!DataValidator::IsValidDate(d));
+    /**
+     * @brief The pre-mmap loader's reads: one ifstream::read per field and a heap buffer per string.
+     */
+    class StreamFieldReader
+    {
+        ifstream in;
 
-                cout << "Leave? (1/0): ";
-                InputOutput::SafeReadInt(leave);
+    public:
+        explicit StreamFieldReader(const string &path) : in(path, ios::binary) {}
 
-                if (!leave)
-                {
-                    while (true)
-                    {
-                        cout << "Start (HH:MM): ";
-                        InputOutput::SafeReadString(s);
-                        cout << "End (HH:MM): ";
-                        InputOutput::SafeReadString(e);
-                        if (!DataValidator::IsValidTime(s) || !DataValidator::IsValidTime(e))
-                            cout << "Invalid time format.\n";
-                        else if (!DataValidator::IsStartBeforeEnd(s, e))
-                            cout << "Start time must be strictly before End time.\n";
-                        else
-                            break;
-                    }
-                }
-                FillTimeSheet(lDetails, logDetails, id, sec, d, s, e, leave);
-            }
-            else
-                return;
+        bool ReadInt(int &val) { return static_cast<bool>(in.read(reinterpret_cast<char *>(&val), sizeof(val))); }
+        bool ReadBool(bool &val)
+        {
+            char c;
+            if (!in.read(&c, 1))
+                return false;
+            val = c != 0;
+            return true;
         }
-    }
-};
-
-class StorageManager
-{
-    LabDetails *labDetails;
-    VenueDetails *venueDetails;
-    FacultyDetails *facultyDetails;
-    WorkLogDetails *logDetails;
+        bool ReadString(string &val)
+        {
+            int len;
+            if (!ReadInt(len) || len < 0)
+                return false;
+            char *buf = new char[len + 1];
+            in.read(buf, len);
+            buf[len] = '\0';
+            val = buf;
+            delete[] buf;
+            return static_cast<bool>(in);
+        }
+    };
 
-    void WriteString(ofstream &out, const string &str)
+    static size_t StreamLoadLogs(const string &path, WorkLogDetails &store)
     {
-        int len = str.length();
-        out.write(reinterpret_cast<const char *>(&len), sizeof(int));
-        if (len > 0)
-            out.write(str.c_str(), len);
+        StreamFieldReader in(path);
+        int count = 0;
+        in.ReadInt(count);
+        WorkLog log;
+        int id;
+        bool leave;
+        string secName, d, s, e;
+        for (int i = 0; i < count; i++)
+        {
+            if (!in.ReadInt(id) || !in.ReadString(secName) || !in.ReadBool(leave) || !in.ReadString(d) ||
+                !in.ReadString(s) || !in.ReadString(e))
+                break;
+            log.SetLabId(id);
+            log.SetSectionName(secName);
+            log.SetIsLeave(leave);
+            log.GetActualTiming().Set(d, s, e);
+            store.AddEntry(log);
+        }
+        return store.GetEntryCount();
     }
 
-    string ReadString(ifstream &in)
+    static size_t MappedLoadLogs(const string &path, WorkLogDetails &store)
     {
-        int len;
-        in.read(reinterpret_cast<char *>(&len), sizeof(int));
-        if (len <= 0 || in.eof())
-            return "";
-        char *buf = new char[len + 1];
-        in.read(buf, len);
-        buf[len] = '\0';
-        string result(buf);
-        delete[] buf;
-        return result;
+        MappedFile mf(path);
+        ByteReader in(mf.Data(), mf.Size());
+        int count = 0;
+        in.ReadInt(count);
+        WorkLog log;
+        for (int i = 0; i < count && RecordCodec::ReadLog(in, log); i++)
+            store.AddEntry(log);
+        return store.GetEntryCount();
     }
 
-public:
-    StorageManager(LabDetails *l, VenueDetails *v, FacultyDetails *f, WorkLogDetails *w)
-        : labDetails(l), venueDetails(v), facultyDetails(f), logDetails(w) {}
+    static long FileSize(const string &path)
+    {
+        struct stat st;
+        return stat(path.c_str(), &st) == 0 ? static_cast<long>(st.st_size) : 0;
+    }
 
-    void Save()
+    static int Startup(size_t count)
     {
-        // Persist Venue Data
-        ofstream vOut("venue.dat", ios::binary);
-        if (vOut.is_open())
+        static const char *const ROW_FILE = "logs_rows.dat";
+        vector<WorkLog> logs = TermLogs(count);
         {
-            auto &bldgs = venueDetails->GetAllBuildings();
-            int bCount = bldgs.size();
-            vOut.write(reinterpret_cast<const char *>(&bCount), sizeof(int));
-            for (auto &b : bldgs)
-            {
-                int id = b.GetId();
-                vOut.write(reinterpret_cast<const char *>(&id), sizeof(int));
-                WriteString(vOut, b.GetName());
-            }
-
-            auto &rooms = venueDetails->GetAllRooms();
-            int rCount = rooms.size();
-            vOut.write(reinterpret_cast<const char *>(&rCount), sizeof(int));
-            for (auto &r : rooms)
+            ByteWriter out;
+            out.WriteInt(static_cast<int>(count));
+            for (const auto &log : logs)
+                RecordCodec::WriteLog(out, log);
+            InMemoryLabDetails labs;
+            InMemoryVenueDetails venues;
+            InMemoryFacultyDetails faculty;
+            SegmentedWorkLogDetails store;
+            store.AddEntries(logs);
+            ChangeJournal journal("journal.dat", ChangeJournal::SYNC_BATCHED);
+            journal.Open(journal.ReadAll());
+            StorageManager storage(&labs, &venues, &faculty, &store, &store, &journal);
+            if (!DiskIO::WriteDurably(ROW_FILE, out.Data()) || !storage.Compact())
             {
-                int id = r.GetId();
-                int bId = r.GetBuildingId();
-                vOut.write(reinterpret_cast<const char *>(&id), sizeof(int));
-                WriteString(vOut, r.GetRoomNumber());
-                vOut.write(reinterpret_cast<const char *>(&bId), sizeof(int));
+                cout << "Error: cannot write the benchmark files.\n";
+                return 1;
             }
-            vOut.close();
         }
+        logs.clear();
+        logs.shrink_to_fit();
 
-        // Persist Faculty Data
-        ofstream fOut("faculty.dat", ios::binary);
-        if (fOut.is_open())
+        double best[3] = {0, 0, 0};
+        size_t loaded[3] = {0, 0, 0};
+        for (int run = 0; run < REPEATS; run++)
         {
-            auto &teachers = facultyDetails->GetAllTeachers();
-            int tCount = teachers.size();
-            fOut.write(reinterpret_cast<const char *>(&tCount), sizeof(int));
-            for (auto &t : teachers)
+            double ms[3];
             {
-                int id = t.GetId();
-                fOut.write(reinterpret_cast<const char *>(&id), sizeof(int));
-                WriteString(fOut, t.GetName());
+                ColumnarWorkLogDetails store;
+                auto started = chrono::steady_clock::now();
+                loaded[0] = StreamLoadLogs(ROW_FILE, store);
+                ms[0] = Millis(started);
+            }
+            {
+                ColumnarWorkLogDetails store;
+                auto started = chrono::steady_clock::now();
+                loaded[1] = MappedLoadLogs(ROW_FILE, store);
+                ms[1] = Millis(started);
             }
-
-            auto &tas = facultyDetails->GetAllTAs();
-            int taCount = tas.size();
-            fOut.write(reinterpret_cast<const char *>(&taCount), sizeof(int));
-            for (auto &t : tas)
             {
-                int id = t.GetId();
-                fOut.write(reinterpret_cast<const char *>(&id), sizeof(int));
-                WriteString(fOut, t.GetName());
+                InMemoryLabDetails labs;
+                InMemoryVenueDetails venues;
+                InMemoryFacultyDetails faculty;
+                SegmentedWorkLogDetails store;
+                ChangeJournal journal("journal.dat", ChangeJournal::SYNC_BATCHED);
+                StorageManager storage(&labs, &venues, &faculty, &store, &store, &journal);
+                streambuf *console = cout.rdbuf(nullptr);
+                auto started = chrono::steady_clock::now();
+                storage.Load();
+                ms[2] = Millis(started);
+                cout.rdbuf(console);
+                cout.clear();
+                loaded[2] = store.GetEntryCount();
             }
-            fOut.close();
+            for (int i = 0; i < 3; i++)
+                best[i] = run == 0 ? ms[i] : min(best[i], ms[i]);
         }
 
-        // Persist Schedule
-        ofstream sOut("schedule.dat", ios::binary);
-        if (sOut.is_open())
+        static const char *const NAMES[3] = {"ifstream, row layout", "MappedFile, row layout", "Load(), snapshot"};
+        long bytes[3] = {FileSize(ROW_FILE), FileSize(ROW_FILE), FileSize("logs.dat")};
+        cout << "Logs: " << count << "\n";
+        cout << left << setw(26) << "Reader" << setw(14) << "File bytes" << setw(12) << "Load ms" << "Mlog/s\n";
+        for (int i = 0; i < 3; i++)
+            cout << fixed << setprecision(2) << left << setw(26) << NAMES[i] << setw(14) << bytes[i] << setw(12)
+                 << best[i] << count / best[i] / 1000 << "\n";
+        cout << "MappedFile is " << best[0] / best[1] << "x faster than ifstream on the same file.\n";
+        cout.unsetf(ios::fixed);
+        cout << setprecision(6);
+
+        if (loaded[0] != count || loaded[1] != count || loaded[2] != count)
         {
-            auto &labs = labDetails->GetAllLabs();
-            int lCount = labs.size();
-            sOut.write(reinterpret_cast<const char *>(&lCount), sizeof(int));
-            for (auto &lab : labs)
-            {
-                int id = lab.GetLabId();
-                sOut.write(reinterpret_cast<const char *>(&id), sizeof(int));
-                WriteString(sOut, lab.GetCourseCode());
-
-                auto &secs = lab.GetSections();
-                int sCount = secs.size();
-                sOut.write(reinterpret_cast<const char *>(&sCount), sizeof(int));
-                for (auto &sec : secs)
-                {
-                    WriteString(sOut, sec.GetSectionName());
-
-                    int tId = (sec.GetTeacher() ? sec.GetTeacher()->GetId() : -1);
-                    int bId = (sec.GetBuilding() ? sec.GetBuilding()->GetId() : -1);
-                    int rId = (sec.GetRoom() ? sec.GetRoom()->GetId() : -1);
+            cout << "Error: a loader did not read back every log.\n";
+            return 1;
+        }
+        return 0;
+    }
 
-                    sOut.write(reinterpret_cast<const char *>(&tId), sizeof(int));
-                    sOut.write(reinterpret_cast<const char *>(&bId), sizeof(int));
-                    sOut.write(reinterpret_cast<const char *>(&rId), sizeof(int));
+    /**
+     * @brief A log row as the store held it before the columnar layout.
+     */
+    struct RowLog
+    {
+        int labId;
+        string sectionName;
+        DateAndTime timing;
+        bool isLeave;
+    };
 
-                    WriteString(sOut, sec.GetScheduleTime().GetDate());
-                    WriteString(sOut, sec.GetScheduleTime().GetStartTime());
-                    WriteString(sOut, sec.GetScheduleTime().GetEndTime());
+    static vector<LabLogSummary> SummarizeRows(const vector<RowLog> &rows)
+    {
+        unordered_map<int, LabLogSummary> totals;
+        for (const auto &r : rows)
+        {
+            LabLogSummary &t = totals.emplace(r.labId, LabLogSummary{r.labId, 0, 0, 0}).first->second;
+            t.entries++;
+            if (r.isLeave)
+                t.leaves++;
+            else
+                t.presentMinutes += r.timing.GetDurationMinutes();
+        }
+        vector<LabLogSummary> out;
+        for (const auto &t : totals)
+            out.push_back(t.second);
+        sort(out.begin(), out.end(), [](const LabLogSummary &a, const LabLogSummary &b)
+             { return a.labId < b.labId; });
+        return out;
+    }
 
-                    auto &tas = sec.GetAssistants();
-                    int taCount = tas.size();
-                    sOut.write(reinterpret_cast<const char *>(&taCount), sizeof(int));
-                    for (auto *ta : tas)
-                    {
-                        int taId = ta ? ta->GetId() : -1;
-                        sOut.write(reinterpret_cast<const char *>(&taId), sizeof(int));
-                    }
-                }
-            }
-            sOut.close();
+    static int Aggregate(size_t count)
+    {
+        ColumnarWorkLogDetails columns;
+        vector<RowLog> rows;
+        {
+            vector<WorkLog> logs = TermLogs(count);
+            columns.AddEntries(logs);
+            rows.reserve(count);
+            for (const auto &log : logs)
+                rows.push_back({log.GetLabId(), log.GetSectionName(), log.GetActualTiming(), log.GetIsLeave()});
         }
 
-        // Persist Logs
-        ofstream lOut("logs.dat", ios::binary);
-        if (lOut.is_open())
+        double rowMs = 0, columnMs = 0;
+        vector<LabLogSummary> byRows, byColumns;
+        for (int run = 0; run < REPEATS; run++)
         {
-            auto &logs = logDetails->GetAllEntries();
-            int logCount = logs.size();
-            lOut.write(reinterpret_cast<const char *>(&logCount), sizeof(int));
-            for (auto &log : logs)
-            {
-                int id = log.GetLabId();
-                lOut.write(reinterpret_cast<const char *>(&id), sizeof(int));
-                WriteString(lOut, log.GetSectionName());
-                bool leave = log.GetIsLeave();
-                lOut.write(reinterpret_cast<const char *>(&leave), sizeof(bool));
-                WriteString(lOut, log.GetActualTiming().GetDate());
-                WriteString(lOut, log.GetActualTiming().GetStartTime());
-                WriteString(lOut, log.GetActualTiming().GetEndTime());
-            }
-            lOut.close();
+            auto started = chrono::steady_clock::now();
+            byRows = SummarizeRows(rows);
+            double ms = Millis(started);
+            rowMs = run == 0 ? ms : min(rowMs, ms);
+
+            started = chrono::steady_clock::now();
+            byColumns = columns.SummarizeByLab();
+            ms = Millis(started);
+            columnMs = run == 0 ? ms : min(columnMs, ms);
         }
 
-        cout << "Data Saved Successfully.\n";
+        size_t entries = 0, leaves = 0;
+        long minutes = 0;
+        for (const auto &t : byColumns)
+        {
+            entries += t.entries;
+            leaves += t.leaves;
+            minutes += t.presentMinutes;
+        }
+        cout << "Logs: " << count << " in " << byColumns.size() << " labs | hours " << minutes / 60 << " | leave ratio "
+             << static_cast<double>(leaves) / max<size_t>(entries, 1) << "\n";
+        cout << left << setw(10) << "Layout" << setw(12) << "Row bytes" << setw(12) << "Sum ms" << "Mlog/s\n";
+        cout << fixed << setprecision(2) << left << setw(10) << "rows" << setw(12) << sizeof(RowLog) << setw(12)
+             << rowMs << count / rowMs / 1000 << "\n";
+        // Lab slot, section ID, day, start and end minute, and one leave bit
+        double columnBytes = sizeof(uint32_t) + sizeof(SymbolId) + sizeof(int32_t) + 2 * sizeof(uint16_t) + 1.0 / 8;
+        cout << left << setw(10) << "columns" << setw(12) << columnBytes << setw(12) << columnMs << count / columnMs / 1000
+             << "\n";
+        cout << "Columns are " << rowMs / columnMs << "x faster.\n";
+        cout.unsetf(ios::fixed);
+        cout << setprecision(6);
+
+        bool same = byRows.size() == byColumns.size();
+        for (size_t i = 0; same && i < byRows.size(); i++)
+            same = byRows[i].labId == byColumns[i].labId && byRows[i].entries == byColumns[i].entries &&
+                   byRows[i].leaves == byColumns[i].leaves && byRows[i].presentMinutes == byColumns[i].presentMinutes;
+        if (!same)
+        {
+            cout << "Error: the two summaries differ.\n";
+            return 1;
+        }
+        return 0;
     }
 
-    void Load()
+    /**
+     * @brief Writes a snapshot of 'sections' sections, then returns the best cold-load time in ms.
+     */
+    static double TimeLoad(size_t sections)
     {
-        // Load Venue Data
-        ifstream vIn("venue.dat", ios::binary);
-        if (vIn.is_open())
         {
-            int bCount;
-            vIn.read(reinterpret_cast<char *>(&bCount), sizeof(int));
-            for (int i = 0; i < bCount && !vIn.eof(); i++)
-            {
-                int id;
-                vIn.read(reinterpret_cast<char *>(&id), sizeof(int));
-                string name = ReadString(vIn);
-                venueDetails->AddBuilding(CampusBlock(id, name));
-            }
-
-            int rCount;
-            vIn.read(reinterpret_cast<char *>(&rCount), sizeof(int));
-            for (int i = 0; i < rCount && !vIn.eof(); i++)
-            {
-                int id, bId;
-                vIn.read(reinterpret_cast<char *>(&id), sizeof(int));
-                string num = ReadString(vIn);
-                vIn.read(reinterpret_cast<char *>(&bId), sizeof(int));
-
-                CampusBlock *b = venueDetails->FindBuilding(bId);
-                venueDetails->AddRoom(LectureHall(id, num, bId, b));
-            }
-            vIn.close();
+            InMemoryLabDetails labs;
+            InMemoryVenueDetails venues;
+            InMemoryFacultyDetails faculty;
+            SegmentedWorkLogDetails logs;
+            Populate(sections, labs, venues, faculty);
+            ChangeJournal journal("journal.dat", ChangeJournal::SYNC_BATCHED);
+            journal.Open(journal.ReadAll());
+            StorageManager storage(&labs, &venues, &faculty, &logs, &logs, &journal);
+            if (!storage.Compact())
+                return -1;
         }
 
-        // Load Faculty Data
-        ifstream fIn("faculty.dat", ios::binary);
-        if (fIn.is_open())
+        double best = 0;
+        for (int run = 0; run < REPEATS; run++)
         {
-            int tCount;
-            fIn.read(reinterpret_cast<char *>(&tCount), sizeof(int));
-            for (int i = 0; i < tCount && !fIn.eof(); i++)
-            {
-                int id;
-                fIn.read(reinterpret_cast<char *>(&id), sizeof(int));
-                string name = ReadString(fIn);
-                facultyDetails->AddTeacher(UniversityTeacher(id, name));
-            }
-            int taCount;
-            fIn.read(reinterpret_cast<char *>(&taCount), sizeof(int));
-            for (int i = 0; i < taCount && !fIn.eof(); i++)
-            {
-                int id;
-                fIn.read(reinterpret_cast<char *>(&id), sizeof(int));
-                string name = ReadString(fIn);
-                facultyDetails->AddTA(TeachingAssistant(id, name));
-            }
-            fIn.close();
+            InMemoryLabDetails labs;
+            InMemoryVenueDetails venues;
+            InMemoryFacultyDetails faculty;
+            SegmentedWorkLogDetails logs;
+            ChangeJournal journal("journal.dat", ChangeJournal::SYNC_BATCHED);
+            StorageManager storage(&labs, &venues, &faculty, &logs, &logs, &journal);
+
+            streambuf *console = cout.rdbuf(nullptr); // Load reports to the console
+            auto started = chrono::steady_clock::now();
+            storage.Load();
+            double ms = Millis(started);
+            cout.rdbuf(console);
+            cout.clear();
+
+            if (labs.GetAllLabs().size() != (sections + 3) / 4)
+                return -1;
+            best = run == 0 ? ms : min(best, ms);
         }
+        return best;
+    }
 
-        // Load Schedule Data
-        ifstream sIn("schedule.dat", ios::binary);
-        if (sIn.is_open())
+    static int Load(size_t sections)
+    {
+        cout << left << setw(12) << "Sections" << setw(12) << "Entities" << setw(12) << "Load ms"
+             << "us/section\n";
+        int status = 0;
+        for (size_t n = sections; n <= sections * 8; n *= 2)
         {
-            int lCount;
-            sIn.read(reinterpret_cast<char *>(&lCount), sizeof(int));
-            for (int i = 0; i < lCount && !sIn.eof(); i++)
+            double ms = TimeLoad(n);
+            if (ms < 0)
             {
-                CourseLaboratory lab;
-                int id;
-                sIn.read(reinterpret_cast<char *>(&id), sizeof(int));
-                lab.SetLabId(id);
-                lab.SetCourseCode(ReadString(sIn));
-
-                int sCount;
-                sIn.read(reinterpret_cast<char *>(&sCount), sizeof(int));
-                for (int j = 0; j < sCount; j++)
-                {
-                    ClassSection sec;
-                    sec.SetSectionName(ReadString(sIn));
-
-                    int tId, bId, rId;
-                    sIn.read(reinterpret_cast<char *>(&tId), sizeof(int));
-                    sIn.read(reinterpret_cast<char *>(&bId), sizeof(int));
-                    sIn.read(reinterpret_cast<char *>(&rId), sizeof(int));
-
-                    sec.SetTeacher(facultyDetails->FindTeacher(tId));
-                    sec.SetBuilding(venueDetails->FindBuilding(bId));
-                    sec.SetRoom(venueDetails->FindRoom(rId));
-
-                    string d = ReadString(sIn);
-                    string s = ReadString(sIn);
-                    string e = ReadString(sIn);
-                    sec.GetScheduleTime().Set(d, s, e);
-
-                    int taCount;
-                    sIn.read(reinterpret_cast<char *>(&taCount), sizeof(int));
-                    for (int k = 0; k < taCount; k++)
-                    {
-                        int taId;
-                        sIn.read(reinterpret_cast<char *>(&taId), sizeof(int));
-                        TeachingAssistant *ta = facultyDetails->FindTA(taId);
-                        if (ta)
-                            sec.AddTA(ta);
-                    }
-                    lab.AddSection(sec);
-                }
-                labDetails->AddLab(lab);
+                cout << "Error: the snapshot of " << n << " sections did not load back.\n";
+                status = 1;
+                break;
             }
-            sIn.close();
+            size_t rooms = n / 10 + 1;
+            size_t entities = rooms + rooms / 20 + 1 + 2 * (n / 5 + 1);
+            cout << fixed << setprecision(2) << left << setw(12) << n << setw(12) << entities << setw(12) << ms
+                 << ms * 1000 / n << "\n";
         }
+        cout.unsetf(ios::fixed);
+        cout << setprecision(6);
+        return status;
+    }
 
-        // Load Logs
-        ifstream lIn("logs.dat", ios::binary);
-        if (lIn.is_open())
+public:
+    static int Run(const string &name, size_t n)
+    {
+        Scratch scratch;
+        if (!scratch.Entered())
         {
-            int count;
-            lIn.read(reinterpret_cast<char *>(&count), sizeof(int));
-            for (int i = 0; i < count && !lIn.eof(); i++)
-            {
-                WorkLog log;
-                int id;
-                lIn.read(reinterpret_cast<char *>(&id), sizeof(int));
-                log.SetLabId(id);
-                log.SetSectionName(ReadString(lIn));
-                bool leave;
-                lIn.read(reinterpret_cast<char *>(&leave), sizeof(bool));
-                log.SetIsLeave(leave);
-
-                string d = ReadString(lIn);
-                string s = ReadString(lIn);
-                string e = ReadString(lIn);
-                log.GetActualTiming().Set(d, s, e);
-                logDetails->AddEntry(log);
-            }
-            lIn.close();
+            cout << "Cannot create the " << SCRATCH_DIR << " directory.\n";
+            return 1;
         }
-
-        cout << "Data Loaded.\n";
+        if (name == "load")
+            return Load(n > 0 ? n : 20000);
+        if (name == "startup")
+            return Startup(n > 0 ? n : 1000000);
+        if (name == "aggregate")
+            return Aggregate(n > 0 ? n : 10000000);
+        cout << "Usage: --bench load|startup|aggregate [n]\n";
+        return 1;
     }
 };
 
-int main()
-{
-    InMemoryLabDetails labDetails;
-    InMemoryVenueDetails venueDetails;
-    InMemoryFacultyDetails facultyDetails;
-    InMemoryWorkLogDetails logDetails;
+const char *const StoreBenchmark::SCRATCH_DIR = "bench.tmp";
+#endif
+
+const char *const StorageManager::SNAPSHOT_FILES[4] = {"venue.dat", "faculty.dat", "schedule.dat", "logs.dat"};
+const char *const SegmentedWorkLogDetails::INDEX_FILE = "logs_index.dat";
+const char *const SegmentedWorkLogDetails::ARCHIVE_FILE = "logs_archive.dat";
 
-    StorageManager storage(&labDetails, &venueDetails, &facultyDetails, &logDetails);
+/**
+ * @brief Entry point.
+ * * No arguments: interactive console menus.
+ * --serve [port] [workers]: serve the role operations to local clients (POSIX only).
+ * --loadgen [clients] [requests] [port]: drive a running server and report latency.
+ * --bench <name> [n]: time the stores on synthetic data in a scratch directory (POSIX only).
+ * --stress [ops]: throughput of the thread-safe store views against thread count.
+ */
+int main(int argc, char **argv)
+{
+    string mode = argc > 1 ? argv[1] : "";
+    if (mode == "--logbench")
+        return LogCodecBenchmark::Run(argc > 2 ? static_cast<size_t>(max(1, atoi(argv[2]))) : 1000000);
+    if (mode == "--stress")
+        return ConcurrencyStress::Run(argc > 2 ? static_cast<size_t>(max(1, atoi(argv[2]))) : 200000);
+#ifndef _WIN32
+    if (mode == "--loadgen")
+        return LoadGenerator::Run(argc > 4 ? atoi(argv[4]) : RoleServer::DEFAULT_PORT,
+                                  argc > 2 ? max(1, atoi(argv[2])) : 16, argc > 3 ? max(1, atoi(argv[3])) : 1000);
+    if (mode == "--bench")
+        return StoreBenchmark::Run(argc > 2 ? argv[2] : "", argc > 3 ? static_cast<size_t>(max(0, atoi(argv[3]))) : 0);
+#else
+    if (mode == "--serve" || mode == "--loadgen" || mode == "--bench")
+    {
+        cout << "Server and benchmark modes are only available on POSIX systems.\n";
+        return 1;
+    }
+#endif
+
+    InMemoryLabDetails labStore;
+    InMemoryVenueDetails venueStore;
+    InMemoryFacultyDetails facultyStore;
+    SegmentedWorkLogDetails logStore;
+
+    // Registered before loading so the index sees every persisted section
+    ScheduleConflictIndex conflicts;
+    labStore.AddObserver(&conflicts);
+    MakeupSlotAdvisor slotAdvisor;
+    labStore.AddObserver(&slotAdvisor);
+    WeeklyScheduleView weeklyView;
+    labStore.AddObserver(&weeklyView);
+    RoomUtilization roomUsage;
+    labStore.AddObserver(&roomUsage);
+    FacultyWorkload workload;
+    labStore.AddObserver(&workload);
+
+    // Thread-safe views over the stores; everything below goes through them
+    ConcurrentLabDetails sharedLabs(&labStore);
+    ConcurrentVenueDetails sharedVenues(&venueStore);
+    ConcurrentFacultyDetails sharedFaculty(&facultyStore);
+    ConcurrentWorkLogDetails sharedLogs(&logStore);
+
+    ChangeJournal journal("journal.dat", ChangeJournal::SYNC_EVERY_RECORD);
+    StorageManager storage(&sharedLabs, &sharedVenues, &sharedFaculty, &sharedLogs, &logStore, &journal);
     storage.Load();
 
+    MakeupRequestQueue makeupQueue("makeup_requests.dat");
+    makeupQueue.Load(&sharedLabs);
+
+    // Roles mutate through the journaled views so every change is durable immediately
+    JournaledLabDetails labDetails(&sharedLabs, &journal);
+    JournaledVenueDetails venueDetails(&sharedVenues, &journal);
+    JournaledFacultyDetails facultyDetails(&sharedFaculty, &journal);
+    JournaledWorkLogDetails logDetails(&sharedLogs, &journal);
+
+#ifndef _WIN32
+    if (mode == "--serve")
+    {
+        RequestHandler handler(&sharedLabs, &logDetails, &makeupQueue);
+        RoleServer server(handler, argc > 2 ? atoi(argv[2]) : RoleServer::DEFAULT_PORT,
+                          argc > 3 ? static_cast<unsigned>(atoi(argv[3])) : thread::hardware_concurrency());
+        int status = server.Run();
+        storage.Save();
+        return status;
+    }
+#endif
+
     HOD hod;
     AcademicOfficer officer;
     Instructor instructor;
@@ -1912,13 +9554,13 @@ int main()
         switch (role)
         {
         case 1:
-            hod.ShowMenu(&labDetails, &logDetails);
+            hod.ShowMenu(&labDetails, &logDetails, &venueDetails, &weeklyView, &roomUsage, &workload);
             break;
         case 2:
-            officer.ShowMenu(&labDetails, &venueDetails, &facultyDetails);
+            officer.ShowMenu(&labDetails, &venueDetails, &facultyDetails, &conflicts, &makeupQueue, &slotAdvisor, &workload, &journal);
             break;
         case 3:
-            instructor.ShowMenu(&labDetails);
+            instructor.ShowMenu(&labDetails, &makeupQueue);
             break;
         case 4:
             attendant.ShowMenu(&labDetails, &logDetails);
@@ -1927,5 +9569,6 @@ int main()
             storage.Save();
             return 0;
         }
+        storage.CompactIfNeeded();
     }
-}
\ No newline at end of file
+}